@@ -314,6 +314,8 @@ unix:!macx {
     #QMAKE_CXXFLAGS += -Wno-dangling-field
     QMAKE_CXXFLAGS += -Wno-unused-const-variable
     LIBS += -ldl
+    # worker threads for the word ladder batch mode
+    LIBS += -lpthread
 }
 
 # set up configuration flags used internally by the Stanford C++ libraries
@@ -8,6 +8,8 @@
  * Used to implement comparison operators like < and >= on collections.
  *
  * @author Marty Stepp
+ * @version 2026/10/18
+ * - added NodePool for collections that allocate one node per element
  * @version 2017/09/29
  * - added compareTo1-5
  * @version 2016/12/09
@@ -23,7 +25,10 @@
 #ifndef _collections_h
 #define _collections_h
 
+#include <algorithm>
 #include <iostream>
+#include <new>
+#include <vector>
 #include "error.h"
 #include "hashcode.h"
 #include "random.h"
@@ -614,6 +619,93 @@ std::ostream& writeMap(std::ostream& out, const MapType& map) {
     return out;
 }
 
+/*
+ * Class: NodePool<NodeType>
+ * -------------------------
+ * An arena of nodes for a linked collection such as Map, which would
+ * otherwise call new and delete once per element.  Nodes are carved out
+ * of blocks that double in size up to MAX_BLOCK_SIZE nodes, and a
+ * destroyed node goes on a free list to be handed out again.  reset
+ * forgets every node at once while keeping the blocks, so a collection
+ * that is cleared and filled again does not allocate.  Each collection
+ * owns its own pool, so threads that fill separate collections never
+ * contend for it.
+ */
+template <typename NodeType>
+class NodePool {
+public:
+    NodePool() : freeList(nullptr), currentBlock(-1), used(0) {
+        // empty
+    }
+
+    ~NodePool() {
+        for (void* block : blocks) {
+            ::operator delete(block);
+        }
+    }
+
+    /*
+     * Returns a new value-initialized node.
+     */
+    NodeType* create() {
+        return new (allocate()) NodeType();
+    }
+
+    /*
+     * Destroys a node and keeps its memory for the next create.
+     */
+    void destroy(NodeType* node) {
+        node->~NodeType();
+        *reinterpret_cast<void**>(node) = freeList;
+        freeList = node;
+    }
+
+    /*
+     * Makes every block available again.  The caller must already have
+     * destroyed any nodes whose destructors have work to do.
+     */
+    void reset() {
+        freeList = nullptr;
+        currentBlock = -1;
+        used = 0;
+    }
+
+private:
+    static const int FIRST_BLOCK_SIZE = 8;
+    static const int MAX_BLOCK_SIZE = 1024;
+
+    static_assert(sizeof(NodeType) >= sizeof(void*),
+                  "NodePool needs room in each free node for a pointer");
+
+    std::vector<void*> blocks;   // blocks[i] holds blockSize(i) nodes
+    void* freeList;              // destroyed nodes, linked through their first bytes
+    int currentBlock;            // block that new nodes are carved from, or -1
+    int used;                    // nodes carved from the current block so far
+
+    NodePool(const NodePool&);              // pools are never copied
+    NodePool& operator =(const NodePool&);
+
+    static int blockSize(int index) {
+        return index >= 7 ? MAX_BLOCK_SIZE : std::min(FIRST_BLOCK_SIZE << index, MAX_BLOCK_SIZE);
+    }
+
+    void* allocate() {
+        if (freeList) {
+            void* node = freeList;
+            freeList = *static_cast<void**>(node);
+            return node;
+        }
+        if (currentBlock == -1 || used == blockSize(currentBlock)) {
+            currentBlock++;
+            used = 0;
+            if (currentBlock == (int) blocks.size()) {
+                blocks.push_back(::operator new(blockSize(currentBlock) * sizeof(NodeType)));
+            }
+        }
+        return static_cast<char*>(blocks[currentBlock]) + sizeof(NodeType) * used++;
+    }
+};
+
 } // namespace collections
 } // namespace stanfordcpplib
 
@@ -11,10 +11,17 @@
  * format.  The STL set is for words added piecemeal at runtime.
  *
  * The DAWG idea comes from an article by Appel & Jacobson, CACM May 1988.
- * This lexicon implementation only has the code to load/search the DAWG.
- * The DAWG builder code is quite a bit more intricate, see Julie Zelenski
- * if you need it.
+ * Words in alphabetical order are built into a minimal DAWG by DawgBuilder,
+ * following the incremental construction for sorted input by Daciuk,
+ * Mihov, Watson & Watson, Computational Linguistics 26(1), 2000.
  * 
+ * @version 2026/10/18
+ * - builds a minimal DAWG from text files whose words are in alphabetical order
+ * - added writeBinaryFile method
+ * - binary files opened by name are memory-mapped and used in place
+ * - edges are 4 bytes read with shifts and masks instead of bitfields
+ * - added setChildScan method to search children with SSE2 or AVX2
+ * - added methods containsBatch, neighborsAt
  * @version 2016/08/10
  * - added constructor support for std initializer_list usage, such as {"a", "b", "c"}
  * @version 2016/08/04
@@ -37,34 +44,171 @@
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <stdint.h>
 #include <string>
+#include <vector>
 #include "collections.h"
 #include "error.h"
 #include "hashcode.h"
 #include "strlib.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// The SSE2 and AVX2 child scans are compiled for x86 processors with GCC
+// or Clang, whatever the target of the rest of the file, and only run once
+// the processor has been checked to support them
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define DAWG_X86_CHILD_SCAN
+#include <immintrin.h>
+#endif
+
+static bool isDawgWord(const std::string& word);
+static void writeBigEndian(uint32_t value, char* bytes);
+
+/*
+ * The DAWG is stored as an array of edges, each one 32 bits whose layout
+ * is described with Edge in dawglexicon.h.  The children of a node are
+ * laid out contiguously in alphabetical order, and the "lastEdge" bit
+ * marks the last edge in a sequence of children.  The edges are kept in
+ * memory just as they are in the file, in big-endian format, so that a
+ * file can be mapped and used without converting it.
+ */
 
-static uint32_t my_ntohl(uint32_t arg);
+static const uint32_t MAX_EDGES = 1u << 24;   // child indexes have 24 bits
 
 /*
- * The DAWG is stored as an array of edges. Each edge is represented by
- * one 32-bit struct.  The 5 "letter" bits indicate the character on this
- * transition (expressed as integer from 1 to 26), the  "accept" bit indicates
- * if you accept after appending that char (current path forms word), and the
- * "lastEdge" bit marks this as the last edge in a sequence of childeren.
- * The bulk of the bits (24) are used for the index within the edge array for
- * the children of this node. The children are laid out contiguously in
- * alphabetical order.  Since we read edges as binary bits from a file in
- * a big-endian format, we have to swap the struct order for little-endian
- * machines.
+ * DawgBuilder reads words in alphabetical order and writes the edges of a
+ * minimal DAWG.  Only the nodes on the path to the last word can still
+ * gain edges, so the edges of each of those nodes are collected in
+ * m_levels.  Once a word leaves a node's subtree for good, the node is
+ * complete, and all of its children are already in m_edges; two complete
+ * nodes with the same edges have the same words below them, so the node
+ * takes the place of an equal node written earlier, found in m_register,
+ * or is written as a new sequence of edges.  Nodes are completed from the
+ * bottom up, which leaves every subtree that occurs more than once stored
+ * once.
  */
+class DawgLexicon::DawgBuilder {
+public:
+    // pre: lex is empty
+    DawgBuilder(DawgLexicon& lex) : m_lex(lex), m_wordCount(0), m_finished(false) {
+        m_edges.push_back(0);   // children index 0 means no children, so edge 0 is never used
+    }
+
+    // pre: word contains only lowercase a-z letters
+    // returns false, without adding the word, if it comes before the last one
+    bool add(const std::string& word) {
+        if (word < m_lastWord) {
+            return false;
+        } else if (word == m_lastWord) {
+            return true;   // duplicate word; already present
+        }
+
+        // the nodes below the prefix shared with the last word are complete
+        size_t shared = 0;
+        while (shared < m_lastWord.length() && m_lastWord[shared] == word[shared]) {
+            shared++;
+        }
+        completeLevels(shared);
+
+        // one new edge for each remaining letter
+        if (m_levels.size() < word.length()) {
+            m_levels.resize(word.length());
+        }
+        for (size_t depth = shared; depth < word.length(); depth++) {
+            m_levels[depth].push_back(word[depth] - 'a' + 1);
+        }
+        m_levels[word.length() - 1].back() |= Edge::ACCEPT;
+        m_wordCount++;
+        m_lastWord = word;
+        return true;
+    }
+
+    // completes the DAWG and gives it to the lexicon; no more words can be added
+    void finish() {
+        if (m_finished) {
+            return;
+        }
+        m_finished = true;
+        completeLevels(0);
+        if (m_wordCount == 0) {
+            return;
+        }
+        // the root is never the child of another node, so it isn't registered
+        m_levels[0].back() |= Edge::LAST_EDGE;
+        uint32_t rootIndex = appendEdges(m_levels[0]);
+        m_lex.numEdges = m_edges.size();
+        Edge* edges = new Edge[m_lex.numEdges];
+        for (size_t i = 0; i < m_edges.size(); i++) {
+            writeBigEndian(m_edges[i], (char*) &edges[i]);
+        }
+        m_lex.edges = edges;
+        m_lex.start = &edges[rootIndex];
+        m_lex.numDawgWords = m_wordCount;
+    }
+
+private:
+    // completes the nodes deeper than the given depth on the path to the
+    // last word, from the bottom up, and links each one to its parent's edge
+    void completeLevels(size_t depth) {
+        for (size_t level = m_lastWord.length(); level > depth; level--) {
+            uint32_t children = 0;
+            if (level < m_levels.size() && !m_levels[level].empty()) {
+                children = registerNode(m_levels[level]);
+                m_levels[level].clear();
+            }
+            m_levels[level - 1].back() |= children << Edge::CHILDREN_SHIFT;
+        }
+    }
+
+    // returns the index of the edges of an equal node written earlier,
+    // writing the node's edges first if there is none
+    uint32_t registerNode(std::vector<uint32_t>& nodeEdges) {
+        nodeEdges.back() |= Edge::LAST_EDGE;
+        std::map<std::vector<uint32_t>, uint32_t>::iterator it = m_register.find(nodeEdges);
+        if (it != m_register.end()) {
+            return it->second;
+        }
+        uint32_t index = appendEdges(nodeEdges);
+        m_register[nodeEdges] = index;
+        return index;
+    }
+
+    uint32_t appendEdges(const std::vector<uint32_t>& nodeEdges) {
+        uint32_t index = m_edges.size();
+        if (index + nodeEdges.size() > MAX_EDGES) {
+            error("DawgLexicon::addWordsFromFile: Too many words for a DAWG");
+        }
+        m_edges.insert(m_edges.end(), nodeEdges.begin(), nodeEdges.end());
+        return index;
+    }
+
+    /* instance variables */
+    DawgLexicon& m_lex;
+    std::vector<uint32_t> m_edges;                  // edges written so far, as in the file
+    std::vector<std::vector<uint32_t> > m_levels;   // m_levels[d] holds the edges collected so
+                                                    // far for the node at depth d
+    std::map<std::vector<uint32_t>, uint32_t> m_register;   // index of each node's edges,
+                                                            // by its edges
+    std::string m_lastWord;
+    int m_wordCount;
+    bool m_finished;
+};
 
 DawgLexicon::DawgLexicon() :
         edges(nullptr),
         start(nullptr),
         numEdges(0),
-        numDawgWords(0) {
+        numDawgWords(0),
+        mapping(nullptr),
+        mappingSize(0),
+        childScan(SCALAR_SCAN) {
     // empty
 }
 
@@ -72,7 +216,10 @@ DawgLexicon::DawgLexicon(std::istream& input) :
         edges(nullptr),
         start(nullptr),
         numEdges(0),
-        numDawgWords(0) {
+        numDawgWords(0),
+        mapping(nullptr),
+        mappingSize(0),
+        childScan(SCALAR_SCAN) {
     addWordsFromFile(input);
 }
 
@@ -80,7 +227,10 @@ DawgLexicon::DawgLexicon(const std::string& filename) :
         edges(nullptr),
         start(nullptr),
         numEdges(0),
-        numDawgWords(0) {
+        numDawgWords(0),
+        mapping(nullptr),
+        mappingSize(0),
+        childScan(SCALAR_SCAN) {
     addWordsFromFile(filename);
 }
 
@@ -88,7 +238,10 @@ DawgLexicon::DawgLexicon(const DawgLexicon& src) :
         edges(nullptr),
         start(nullptr),
         numEdges(0),
-        numDawgWords(0) {
+        numDawgWords(0),
+        mapping(nullptr),
+        mappingSize(0),
+        childScan(SCALAR_SCAN) {
     deepCopy(src);
 }
 
@@ -96,14 +249,15 @@ DawgLexicon::DawgLexicon(std::initializer_list<std::string> list) :
         edges(nullptr),
         start(nullptr),
         numEdges(0),
-        numDawgWords(0) {
+        numDawgWords(0),
+        mapping(nullptr),
+        mappingSize(0),
+        childScan(SCALAR_SCAN) {
     addAll(list);
 }
 
 DawgLexicon::~DawgLexicon() {
-    if (edges) {
-        delete[] edges;
-    }
+    releaseEdges();
 }
 
 void DawgLexicon::add(const std::string& word) {
@@ -147,8 +301,23 @@ void DawgLexicon::addWordsFromFile(std::istream& input) {
         // plain text file
         input.seekg(0);
         std::string line;
+        if (isEmpty()) {
+            DawgBuilder builder(*this);
+            while (getline(input, line)) {
+                line = toLowerCase(trim(line));
+                if (!isDawgWord(line)) {
+                    add(line);   // can't be spelled in a DAWG, so kept in otherWords
+                } else if (!builder.add(line)) {
+                    // out of order; the rest of the file is added one word at a time
+                    builder.finish();
+                    add(line);
+                    break;
+                }
+            }
+            builder.finish();
+        }
         while (getline(input, line)) {
-            add(line);
+            add(trim(line));
         }
     }
 }
@@ -162,24 +331,31 @@ void DawgLexicon::addWordsFromFile(const std::string& filename) {
     if (input.fail()) {
         error("DawgLexicon::addWordsFromFile: Couldn't open lexicon file " + filename);
     }
+    char firstFour[4];
+    if (input.read(firstFour, 4) && strncmp(firstFour, "DAWG", 4) == 0) {
+        input.close();
+        if (otherWords.size() != 0) {
+            error("DawgLexicon::addWordsFromFile: Binary files require an empty lexicon");
+        }
+        readBinaryFile(filename);
+        return;
+    }
+    input.clear();
     addWordsFromFile(input);
     input.close();
 }
 
 void DawgLexicon::clear() {
-    if (edges) {
-        delete[] edges;
-    }
-    edges = start = nullptr;
-    numEdges = numDawgWords = 0;
+    releaseEdges();
+    numDawgWords = 0;
     otherWords.clear();
 }
 
 bool DawgLexicon::contains(const std::string& word) const {
     std::string copy = word;
     toLowerCaseInPlace(copy);
-    Edge* lastEdge = traceToLastEdge(copy);
-    if (lastEdge && lastEdge->accept) {
+    const Edge* lastEdge = traceToLastEdge(copy);
+    if (lastEdge && lastEdge->accepts()) {
         return true;
     }
     return otherWords.contains(copy);
@@ -203,6 +379,46 @@ bool DawgLexicon::containsAll(std::initializer_list<std::string> list) const {
     return true;
 }
 
+std::vector<bool> DawgLexicon::containsBatch(const std::vector<std::string>& words) const {
+    std::vector<bool> result(words.size(), false);
+    // path[d] is the edge for letter d of the last walk, which spelled out
+    // the letters in walked
+    std::vector<const Edge*> path;
+    std::string walked;
+    for (size_t k = 0; k < words.size(); k++) {
+        std::string copy = words[k];
+        toLowerCaseInPlace(copy);
+        size_t shared = 0;
+        while (shared < walked.length() && shared < copy.length()
+               && walked[shared] == copy[shared]) {
+            shared++;
+        }
+        path.resize(shared);
+        walked.resize(shared);
+        while (start && walked.length() < copy.length()) {
+            const Edge* children = start;
+            if (!path.empty()) {
+                if (!path.back()->children()) {
+                    break;
+                }
+                children = &edges[path.back()->children()];
+            }
+            const Edge* edge = findEdgeForChar(children, copy[walked.length()]);
+            if (!edge) {
+                break;
+            }
+            path.push_back(edge);
+            walked.push_back(copy[walked.length()]);
+        }
+        if (!copy.empty() && walked.length() == copy.length() && path.back()->accepts()) {
+            result[k] = true;
+        } else {
+            result[k] = otherWords.contains(copy);
+        }
+    }
+    return result;
+}
+
 bool DawgLexicon::containsPrefix(const std::string& prefix) const {
     if (prefix.empty()) {
         return true;
@@ -272,7 +488,77 @@ void DawgLexicon::mapAll(void (*fn)(const std::string &)) const {
     }
 }
 
+std::vector<std::string> DawgLexicon::neighborsAt(const std::string& word, int i) const {
+    std::vector<std::string> result;
+    if (i < 0 || i >= (int) word.length()) {
+        return result;
+    }
+    std::string copy = word;
+    toLowerCaseInPlace(copy);
+    char original = copy[i];
+
+    // the edges for the letters that can follow the first i letters
+    const Edge* children = start;
+    if (i > 0) {
+        const Edge* parent = traceToLastEdge(copy.substr(0, i));
+        children = (parent && parent->children()) ? &edges[parent->children()] : nullptr;
+    }
+    for (const Edge* edge = children; edge; edge = edge->isLastEdge() ? nullptr : edge + 1) {
+        char letter = ordToChar(edge->letter());
+        if (letter != original) {
+            const Edge* lastEdge = traceFromEdge(edge, copy, i + 1);
+            if (lastEdge && lastEdge->accepts()) {
+                copy[i] = letter;
+                result.push_back(copy);
+            }
+        }
+    }
+
+    // words added one at a time are looked up letter by letter and merged in
+    if (!otherWords.isEmpty()) {
+        size_t dawgCount = result.size();
+        for (char letter = 'a'; letter <= 'z'; letter++) {
+            copy[i] = letter;
+            if (letter != original && otherWords.contains(copy)) {
+                result.push_back(copy);
+            }
+        }
+        std::inplace_merge(result.begin(), result.begin() + dawgCount, result.end());
+    }
+    return result;
+}
+
+void DawgLexicon::setChildScan(ChildScan scan) {
+    if (!isChildScanSupported(scan)) {
+        error("DawgLexicon::setChildScan: This machine can't run that child scan");
+    }
+    childScan = scan;
+}
+
+DawgLexicon::ChildScan DawgLexicon::getChildScan() const {
+    return childScan;
+}
+
+bool DawgLexicon::isChildScanSupported(ChildScan scan) {
+    switch (scan) {
+    case SCALAR_SCAN:
+        return true;
+#ifdef DAWG_X86_CHILD_SCAN
+    case SSE2_SCAN:
+        return __builtin_cpu_supports("sse2");
+    case AVX2_SCAN:
+        return __builtin_cpu_supports("avx2");
+#endif // DAWG_X86_CHILD_SCAN
+    default:
+        return false;
+    }
+}
+
 int DawgLexicon::size() const {
+    if (numDawgWords < 0) {
+        std::vector<int> counts(numEdges, -1);
+        numDawgWords = countDawgWords((uint32_t) (start - edges), counts);
+    }
     return numDawgWords + otherWords.size();
 }
 
@@ -282,6 +568,45 @@ std::string DawgLexicon::toString() const {
     return out.str();
 }
 
+void DawgLexicon::writeBinaryFile(std::ostream& output) const {
+    if (!otherWords.isEmpty()) {
+        // words added one at a time aren't in the DAWG yet, so build a new
+        // one with every word; iteration is in alphabetical order
+        DawgLexicon all;
+        DawgBuilder builder(all);
+        for (const std::string& word : *this) {
+            if (!isDawgWord(word)) {
+                error("DawgLexicon::writeBinaryFile: Can't write word \"" + word + "\"");
+            }
+            builder.add(word);
+        }
+        builder.finish();
+        all.writeBinaryFile(output);
+        return;
+    }
+
+    // an empty lexicon is written as a single edge that matches no letter;
+    // the edges are already in the file's byte order
+    char emptyEdge[sizeof(Edge)];
+    writeBigEndian(Edge::LAST_EDGE, emptyEdge);
+    const char* edgeData = edges ? (const char*) edges : emptyEdge;
+    int edgeCount = edges ? numEdges : 1;
+    output << "DAWG:" << (edges ? start - edges : 0) << ":" << edgeCount * sizeof(Edge) << ":";
+    output.write(edgeData, edgeCount * sizeof(Edge));
+    if (output.fail()) {
+        error("DawgLexicon::writeBinaryFile: Couldn't write output");
+    }
+}
+
+void DawgLexicon::writeBinaryFile(const std::string& filename) const {
+    std::ofstream output(filename.c_str(), std::ios::out | std::ios::binary);
+    if (output.fail()) {
+        error("DawgLexicon::writeBinaryFile: Couldn't open output file " + filename);
+    }
+    writeBinaryFile(output);
+    output.close();
+}
+
 std::set<std::string> DawgLexicon::toStlSet() const {
     std::set<std::string> result;
     for (std::string word : *this) {
@@ -357,31 +682,78 @@ DawgLexicon& DawgLexicon::operator ,(const std::string& word) {
     return *this;
 }
 
-int DawgLexicon::countDawgWords(Edge* ep) const {
+/*
+ * Implementation notes: countDawgWords
+ * ------------------------------------
+ * Counts the words below the node whose edges start at the given index.
+ * Nodes are shared, so the count of each node is remembered in counts
+ * and every edge is looked at once.  The recursion goes no deeper than
+ * the longest word, as checkEdges has made sure that children always lie
+ * before their parents.
+ */
+int DawgLexicon::countDawgWords(uint32_t node, std::vector<int>& counts) const {
+    if (counts[node] >= 0) {
+        return counts[node];
+    }
     int count = 0;
-    while (true) {
-        if (ep->accept) count++;
-        if (ep->children != 0) {
-            count += countDawgWords(&edges[ep->children]);
+    for (const Edge* ep = &edges[node]; ; ep++) {
+        if (ep->accepts()) count++;
+        if (ep->children() != 0) {
+            count += countDawgWords(ep->children(), counts);
         }
-        if (ep->lastEdge) break;
-        ep++;
+        if (ep->isLastEdge()) break;
     }
+    counts[node] = count;
     return count;
 }
 
+/*
+ * Implementation notes: checkEdges
+ * --------------------------------
+ * Called once the edges of a binary file are in place, so that no lookup
+ * or iteration has to check them again.  The last edge must end a
+ * sequence, so that a walk along any sequence of children stops before
+ * the end of the array.  A DAWG is written bottom-up, so a node's children
+ * are always written before the node itself: every child sequence must
+ * start, and end, before the edge that points to it.  A child index that
+ * points forwards, or into the sequence of its own parent, could make a
+ * cycle, and lookups and iteration would then never end.  The edges are
+ * looked at once, in order; the words are only counted if size is called.
+ */
+void DawgLexicon::checkEdges(long startIndex) {
+    bool valid = numEdges > 0 && startIndex < numEdges
+            && edges[numEdges - 1].isLastEdge();
+    long lastEnd = -1;   // index of the last edge before i that ends a sequence
+    for (long i = 0; valid && i < numEdges; i++) {
+        uint32_t children = edges[i].children();
+        valid = (children == 0 || (long) children <= lastEnd) && edges[i].letter() <= 26;
+        if (edges[i].isLastEdge()) {
+            lastEnd = i;
+        }
+    }
+    if (!valid) {
+        releaseEdges();
+        error("DawgLexicon::addWordsFromFile: Improperly formed lexicon file");
+    }
+    start = &edges[startIndex];
+    numDawgWords = -1;
+}
+
 void DawgLexicon::deepCopy(const DawgLexicon& src) {
     if (!src.edges) {
         edges = nullptr;
         start = nullptr;
     } else {
+        // a mapped file is copied too, so each lexicon owns what it frees
         numEdges = src.numEdges;
-        edges = new Edge[src.numEdges];
-        memcpy(edges, src.edges, sizeof(Edge)*src.numEdges);
+        Edge* copy = new Edge[src.numEdges];
+        memcpy(copy, src.edges, sizeof(Edge)*src.numEdges);
+        edges = copy;
         start = edges + (src.start - src.edges);
     }
     numDawgWords = src.numDawgWords;
     otherWords = src.otherWords;
+    childScan = src.childScan;
 }
 
 /*
@@ -392,19 +764,92 @@ void DawgLexicon::deepCopy(const DawgLexicon& src) {
  * last child without finding a match (thus no such
  * child edge exists).
  */
-DawgLexicon::Edge* DawgLexicon::findEdgeForChar(Edge* children, char ch) const {
-    Edge* curEdge = children;
+const DawgLexicon::Edge* DawgLexicon::findEdgeForChar(const Edge* children, char ch) const {
+    const Edge* curEdge = children;
+#ifdef DAWG_X86_CHILD_SCAN
+    if (childScan == SSE2_SCAN) {
+        curEdge = findEdgeSse2(children, edges + numEdges, charToOrd(ch));
+    } else if (childScan == AVX2_SCAN) {
+        curEdge = findEdgeAvx2(children, edges + numEdges, charToOrd(ch));
+    }
+    if (!curEdge || curEdge->letter() == charToOrd(ch)) {
+        return curEdge;
+    }
+#endif // DAWG_X86_CHILD_SCAN
     while (true) {
-        if (curEdge->letter == charToOrd(ch)) {
+        if (curEdge->letter() == charToOrd(ch)) {
             return curEdge;
         }
-        if (curEdge->lastEdge) {
+        if (curEdge->isLastEdge()) {
             return nullptr;
         }
         curEdge++;
     }
 }
 
+/*
+ * Implementation notes: findEdgeSse2, findEdgeAvx2
+ * ------------------------------------------------
+ * Load 4 or 8 edges at a time.  On x86 the last byte of each edge, which
+ * holds its letter and flags, is the top byte of a 32-bit lane, so one
+ * compare finds the lanes with the letter and another the lanes that end
+ * the sequence.  The match counts only if it comes no later than the end
+ * of the sequence.  Both return the matching edge, nullptr if there is
+ * none, or the first edge not looked at once fewer than a full load of
+ * edges are left in the array, for findEdgeForChar to finish one at a time.
+ */
+#ifdef DAWG_X86_CHILD_SCAN
+__attribute__((target("sse2")))
+const DawgLexicon::Edge* DawgLexicon::findEdgeSse2(const Edge* children, const Edge* end,
+                                                   unsigned int ord) {
+    const __m128i letterMask = _mm_set1_epi32(Edge::LETTER_MASK << 24);
+    const __m128i letter = _mm_set1_epi32(ord << 24);
+    const __m128i lastEdge = _mm_set1_epi32(Edge::LAST_EDGE << 24);
+    const Edge* curEdge = children;
+    for (; end - curEdge >= 4; curEdge += 4) {
+        __m128i lanes = _mm_loadu_si128((const __m128i*) curEdge);
+        __m128i matches = _mm_cmpeq_epi32(_mm_and_si128(lanes, letterMask), letter);
+        __m128i lasts = _mm_cmpeq_epi32(_mm_and_si128(lanes, lastEdge), lastEdge);
+        int matchBits = _mm_movemask_ps(_mm_castsi128_ps(matches));
+        int lastBits = _mm_movemask_ps(_mm_castsi128_ps(lasts));
+        if (lastBits) {
+            matchBits &= (lastBits ^ (lastBits - 1));   // lanes up to the first last edge
+        }
+        if (matchBits) {
+            return curEdge + __builtin_ctz(matchBits);
+        } else if (lastBits) {
+            return nullptr;
+        }
+    }
+    return curEdge;
+}
+
+__attribute__((target("avx2")))
+const DawgLexicon::Edge* DawgLexicon::findEdgeAvx2(const Edge* children, const Edge* end,
+                                                   unsigned int ord) {
+    const __m256i letterMask = _mm256_set1_epi32(Edge::LETTER_MASK << 24);
+    const __m256i letter = _mm256_set1_epi32(ord << 24);
+    const __m256i lastEdge = _mm256_set1_epi32(Edge::LAST_EDGE << 24);
+    const Edge* curEdge = children;
+    for (; end - curEdge >= 8; curEdge += 8) {
+        __m256i lanes = _mm256_loadu_si256((const __m256i*) curEdge);
+        __m256i matches = _mm256_cmpeq_epi32(_mm256_and_si256(lanes, letterMask), letter);
+        __m256i lasts = _mm256_cmpeq_epi32(_mm256_and_si256(lanes, lastEdge), lastEdge);
+        int matchBits = _mm256_movemask_ps(_mm256_castsi256_ps(matches));
+        int lastBits = _mm256_movemask_ps(_mm256_castsi256_ps(lasts));
+        if (lastBits) {
+            matchBits &= (lastBits ^ (lastBits - 1));
+        }
+        if (matchBits) {
+            return curEdge + __builtin_ctz(matchBits);
+        } else if (lastBits) {
+            return nullptr;
+        }
+    }
+    return curEdge;
+}
+#endif // DAWG_X86_CHILD_SCAN
+
 /*
  * Implementation notes: readBinaryFile
  * ------------------------------------
@@ -426,25 +871,20 @@ void DawgLexicon::readBinaryFile(std::istream& input) {
     input >> numBytes;
     input.get();
     if (input.fail() || strncmp(firstFour, expected, 4) != 0
-            || startIndex < 0 || numBytes < 0) {
+            || startIndex < 0 || numBytes < 0 || numBytes % sizeof(Edge) != 0
+            || numBytes / sizeof(Edge) > MAX_EDGES) {
         error("DawgLexicon::addWordsFromFile: Improperly formed lexicon file");
     }
+    releaseEdges();
     numEdges = numBytes / sizeof(Edge);
-    edges = new Edge[numEdges];
-    start = &edges[startIndex];
-    input.read((char*) edges, numBytes);
-    if (input.fail() && !input.eof()) {
+    Edge* buffer = new Edge[numEdges];
+    edges = buffer;
+    input.read((char*) buffer, numBytes);
+    if (input.gcount() != numBytes) {
+        releaseEdges();
         error("DawgLexicon::addWordsFromFile: Improperly formed lexicon file");
     }
-
-#if defined(BYTE_ORDER) && BYTE_ORDER == LITTLE_ENDIAN
-    uint32_t *cur = (uint32_t *) edges;
-    for (int i = 0; i < numEdges; i++, cur++) {
-        *cur = my_ntohl(*cur);
-    }
-#endif
-
-    numDawgWords = countDawgWords(start);
+    checkEdges(startIndex);
 }
 
 /*
@@ -454,6 +894,48 @@ void DawgLexicon::readBinaryFile(std::istream& input) {
  * DAWG:<startnode index>:<num bytes>:<num bytes block of edge data>
  */
 void DawgLexicon::readBinaryFile(const std::string& filename) {
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    struct stat status;
+    void* data = MAP_FAILED;
+    if (fd != -1 && fstat(fd, &status) != -1 && status.st_size > 0) {
+        data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+    if (data != MAP_FAILED) {
+        // parse "DAWG:<start>:<bytes>:" from the mapped header
+        const char* bytes = (const char*) data;
+        size_t size = status.st_size;
+        size_t pos = 5;
+        long numbers[2] = {0, 0};
+        bool valid = size > pos && strncmp(bytes, "DAWG:", 5) == 0;
+        for (int n = 0; valid && n < 2; n++) {
+            size_t digitsStart = pos;
+            while (pos < size && isdigit(bytes[pos]) && pos - digitsStart < 9) {
+                numbers[n] = numbers[n] * 10 + (bytes[pos++] - '0');
+            }
+            valid = pos > digitsStart && pos < size && bytes[pos++] == ':';
+        }
+        long startIndex = numbers[0];
+        long numBytes = numbers[1];
+        if (!valid || numBytes % sizeof(Edge) != 0 || (size_t) numBytes > size - pos
+                || numBytes / sizeof(Edge) > MAX_EDGES) {
+            munmap(data, size);
+            error("DawgLexicon::addWordsFromFile: Improperly formed lexicon file");
+        }
+        releaseEdges();
+        mapping = data;
+        mappingSize = size;
+        numEdges = numBytes / sizeof(Edge);
+        edges = (const Edge*) (bytes + pos);
+        checkEdges(startIndex);
+        return;
+    }
+#endif // _WIN32
+
+    // the file can't be mapped, so its edges are read into memory
 #ifdef _foreachpatch_h
     std::ifstream input(filename.c_str(), __IOS_IN__ | __IOS_BINARY__);
 #else
@@ -466,6 +948,26 @@ void DawgLexicon::readBinaryFile(const std::string& filename) {
     input.close();
 }
 
+/*
+ * Implementation notes: releaseEdges
+ * ----------------------------------
+ * Unmaps the file the edges are in, or frees them if they were read or
+ * built in memory.
+ */
+void DawgLexicon::releaseEdges() {
+    if (mapping) {
+#ifndef _WIN32
+        munmap(mapping, mappingSize);
+#endif // _WIN32
+    } else if (edges) {
+        delete[] edges;
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    edges = start = nullptr;
+    numEdges = 0;
+}
+
 /*
  * Implementation notes: traceToLastEdge
  * -------------------------------------
@@ -473,26 +975,38 @@ void DawgLexicon::readBinaryFile(const std::string& filename) {
  * If a path exists, return last edge; otherwise return nullptr.
  */
 
-DawgLexicon::Edge* DawgLexicon::traceToLastEdge(const std::string& s) const {
+const DawgLexicon::Edge* DawgLexicon::traceToLastEdge(const std::string& s) const {
     if (!start) {
         return nullptr;
     }
-    Edge* curEdge = findEdgeForChar(start, s[0]);
-    int len = (int) s.length();
-    for (int i = 1; i < len; i++) {
-        if (!curEdge || !curEdge->children) {
+    const Edge* curEdge = findEdgeForChar(start, s[0]);
+    return curEdge ? traceFromEdge(curEdge, s, 1) : nullptr;
+}
+
+/*
+ * Implementation notes: traceFromEdge
+ * -----------------------------------
+ * Continues a path from the given edge with the letters of s from index
+ * from on.  Returns the last edge of the path, which is the given edge if
+ * there are no letters left, or nullptr if the path leaves the DAWG.
+ */
+const DawgLexicon::Edge* DawgLexicon::traceFromEdge(const Edge* edge, const std::string& s,
+                                                    size_t from) const {
+    for (size_t i = from; i < s.length(); i++) {
+        if (!edge->children()) {
+            return nullptr;
+        }
+        edge = findEdgeForChar(&edges[edge->children()], s[i]);
+        if (!edge) {
             return nullptr;
         }
-        curEdge = findEdgeForChar(&edges[curEdge->children], s[i]);
     }
-    return curEdge;
+    return edge;
 }
 
 DawgLexicon& DawgLexicon::operator =(const DawgLexicon& src) {
     if (this != &src) {
-        if (edges) {
-            delete[] edges;
-        }
+        releaseEdges();
         deepCopy(src);
     }
     return *this;
@@ -508,9 +1022,9 @@ void DawgLexicon::iterator::advanceToNextWordInSet() {
 }
 
 void DawgLexicon::iterator::advanceToNextEdge() {
-    Edge *ep = edgePtr;
-    if (ep->children == 0) {
-        while (ep && ep->lastEdge) {
+    const Edge *ep = edgePtr;
+    if (ep->children() == 0) {
+        while (ep && ep->isLastEdge()) {
             if (stack.isEmpty()) {
                 edgePtr = nullptr;
                 return;
@@ -522,8 +1036,8 @@ void DawgLexicon::iterator::advanceToNextEdge() {
         edgePtr = ep + 1;
     } else {
         stack.push(ep);
-        currentDawgPrefix.push_back(lp->ordToChar(ep->letter));
-        edgePtr = &lp->edges[ep->children];
+        currentDawgPrefix.push_back(lp->ordToChar(ep->letter()));
+        edgePtr = &lp->edges[ep->children()];
     }
 }
 
@@ -533,7 +1047,7 @@ void DawgLexicon::iterator::advanceToNextWordInDawg() {
     } else {
         advanceToNextEdge();
     }
-    while (edgePtr && !edgePtr->accept) {
+    while (edgePtr && !edgePtr->accepts()) {
         advanceToNextEdge();
     }
 }
@@ -552,12 +1066,28 @@ int hashCode(const DawgLexicon& lex) {
 }
 
 /*
- * Swaps a 4-byte long from big to little endian byte order
+ * Returns true if the word can be spelled in a DAWG: at least one letter,
+ * and only lowercase a to z.
  */
-static uint32_t my_ntohl(uint32_t arg) {
-    uint32_t result = ((arg & 0xff000000) >> 24) |
-            ((arg & 0x00ff0000) >> 8) |
-            ((arg & 0x0000ff00) << 8) |
-            ((arg & 0x000000ff) << 24);
-    return result;
+static bool isDawgWord(const std::string& word) {
+    if (word.empty()) {
+        return false;
+    }
+    for (char ch : word) {
+        if (ch < 'a' || ch > 'z') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Stores a 32-bit value as 4 bytes in big-endian byte order, as edges are
+ * laid out in memory and in files
+ */
+static void writeBigEndian(uint32_t value, char* bytes) {
+    bytes[0] = (char) (value >> 24);
+    bytes[1] = (char) (value >> 16);
+    bytes[2] = (char) (value >> 8);
+    bytes[3] = (char) value;
 }
@@ -4,6 +4,13 @@
  * This file exports the <code>DawgLexicon</code> class, which is a
  * compact structure for storing a list of words.
  * 
+ * @version 2026/10/18
+ * - builds a minimal DAWG from text files whose words are in alphabetical order
+ * - added writeBinaryFile method
+ * - binary files opened by name are memory-mapped and used in place
+ * - edges are 4 bytes read with shifts and masks instead of bitfields
+ * - added setChildScan method to search children with SSE2 or AVX2
+ * - added methods containsBatch, neighborsAt
  * @version 2016/09/24
  * - refactored to use collections.h utility functions
  * @version 2016/08/11
@@ -28,7 +35,9 @@
 
 #include <initializer_list>
 #include <set>
+#include <stdint.h>
 #include <string>
+#include <vector>
 #include "set.h"
 #include "stack.h"
 
@@ -84,6 +93,12 @@ public:
      *<pre>
      *    DawgLexicon english("English.dat");
      *</pre>
+     *
+     * A binary file opened by name is mapped into memory and its edges are
+     * used where they lie, so nothing is copied and processes using the
+     * same file share its pages.  Opening it checks each edge once, which
+     * is quick next to reading words; the words are only counted the first
+     * time <code>size</code> is called.
      */
     DawgLexicon();
     DawgLexicon(std::istream& input);
@@ -127,6 +142,9 @@ public:
      * Usage: lex.addWordsFromFile(input);
      * -----------------------------------
      * Reads the input stream and adds all of its words to the lexicon.
+     * If the lexicon is empty and the words of a text file are in
+     * alphabetical order, they are built into a minimal DAWG, the same
+     * compact structure a binary lexicon file holds.
      */
     void addWordsFromFile(std::istream& input);
     
@@ -168,6 +186,18 @@ public:
     bool containsAll(const DawgLexicon& set2) const;
     bool containsAll(std::initializer_list<std::string> list) const;
 
+    /*
+     * Method: containsBatch
+     * Usage: vector<bool> found = lex.containsBatch(words);
+     * -----------------------------------------------------
+     * Returns a vector whose element <i>k</i> is <code>true</code> if
+     * <code>words[k]</code> is contained in the lexicon.  The edges a word
+     * shares with the word before it are not searched again, so words in
+     * alphabetical order, or that only differ near their ends, are looked
+     * up fastest.
+     */
+    std::vector<bool> containsBatch(const std::vector<std::string>& words) const;
+
     /*
      * Method: containsPrefix
      * Usage: if (lex.containsPrefix(prefix)) ...
@@ -243,15 +273,67 @@ public:
     template <typename FunctorType>
     void mapAll(FunctorType fn) const;
 
+    /*
+     * Method: neighborsAt
+     * Usage: vector<string> neighbors = lex.neighborsAt(word, i);
+     * -----------------------------------------------------------
+     * Returns the words in the lexicon that differ from <code>word</code>
+     * only in the letter at index <code>i</code>, in lowercase and in
+     * alphabetical order, not including <code>word</code> itself.  The
+     * DAWG is walked to index <code>i</code> once, and the rest of the word
+     * is only followed from the edges found there.  Returns an empty vector
+     * if <code>i</code> is not an index of <code>word</code>.
+     */
+    std::vector<std::string> neighborsAt(const std::string& word, int i) const;
+
     // implementation note: DawgLexicon does not support removal,
     // so there are no methods remove(), removeAll, retainAll, etc.
     // nor operators -, -=, *=
 
+    /*
+     * Type: ChildScan
+     * ---------------
+     * The ways a lookup can search the children of a node for the next
+     * letter of a word: one edge at a time, or 4 or 8 edges at once with
+     * the SSE2 or AVX2 vector instructions of x86 processors.
+     */
+    enum ChildScan { SCALAR_SCAN, SSE2_SCAN, AVX2_SCAN };
+
+    /*
+     * Method: setChildScan
+     * Usage: lex.setChildScan(DawgLexicon::SSE2_SCAN);
+     * ------------------------------------------------
+     * Chooses how lookups search the children of each node.  All of them
+     * find the same words; only their speed differs.  The default is
+     * <code>SCALAR_SCAN</code>.  Generates an error if this machine can't
+     * run the given scan.
+     */
+    void setChildScan(ChildScan scan);
+
+    /*
+     * Method: getChildScan
+     * Usage: DawgLexicon::ChildScan scan = lex.getChildScan();
+     * --------------------------------------------------------
+     * Returns how lookups search the children of each node.
+     */
+    ChildScan getChildScan() const;
+
+    /*
+     * Method: isChildScanSupported
+     * Usage: if (DawgLexicon::isChildScanSupported(DawgLexicon::AVX2_SCAN)) ...
+     * -------------------------------------------------------------------------
+     * Returns true if this machine can run the given child scan.
+     */
+    static bool isChildScanSupported(ChildScan scan);
+
     /*
      * Method: size
      * Usage: int n = lex.size();
      * --------------------------
-     * Returns the number of words contained in the lexicon.
+     * Returns the number of words contained in the lexicon.  The words of
+     * a binary file are counted the first time this is called, looking at
+     * each edge once, so that first call must not be made from several
+     * threads at once.
      */
     int size() const;
 
@@ -269,6 +351,18 @@ public:
      * a large number of words.
      */
     std::string toString() const;
+
+    /*
+     * Method: writeBinaryFile
+     * Usage: lex.writeBinaryFile(filename);
+     * -------------------------------------
+     * Writes the lexicon in the space-efficient binary format that the
+     * constructors and addWordsFromFile read, so a word list only has to
+     * be built into a DAWG once.  Generates an error if a word contains
+     * anything other than the letters a to z, or the output can't be written.
+     */
+    void writeBinaryFile(std::ostream& output) const;
+    void writeBinaryFile(const std::string& filename) const;
     
     /*
      * Operators: ==, !=
@@ -358,33 +452,59 @@ public:
     DawgLexicon& operator ,(const std::string& word);
 
 private:
-#ifdef _WIN32
-#define LITTLE_ENDIAN 1
-#define BYTE_ORDER LITTLE_ENDIAN
-#endif
-
-#pragma pack(1)
+    /*
+     * One edge of the DAWG, as the 4 bytes of a 32-bit big-endian value,
+     * the same as in a binary file.  The fields are read with shifts and
+     * masks, so the layout doesn't depend on the compiler's bitfield order,
+     * the size of long or the machine's byte order:
+     *
+     *   bits 8-31  index of the first child edge, or 0 for no children
+     *   bit 7      unused
+     *   bit 6      accept: the path up to this edge forms a word
+     *   bit 5      lastEdge: the last edge in a sequence of children
+     *   bits 0-4   letter, 1 to 26
+     */
     struct Edge {
-#if defined(BYTE_ORDER) && BYTE_ORDER == LITTLE_ENDIAN
-        unsigned long letter:5;
-        unsigned long lastEdge:1;
-        unsigned long accept:1;
-        unsigned long unused:1;
-        unsigned long children:24;
-#else
-        unsigned long children:24;
-        unsigned long unused:1;
-        unsigned long accept:1;
-        unsigned long lastEdge:1;
-        unsigned long letter:5;
-#endif
+        enum {
+            LETTER_MASK = 0x1f,
+            LAST_EDGE = 1 << 5,
+            ACCEPT = 1 << 6,
+            CHILDREN_SHIFT = 8
+        };
+
+        unsigned char bytes[4];
+
+        uint32_t value() const {
+            return (uint32_t) bytes[0] << 24 | (uint32_t) bytes[1] << 16
+                    | (uint32_t) bytes[2] << 8 | (uint32_t) bytes[3];
+        }
+
+        unsigned int letter() const {
+            return value() & LETTER_MASK;
+        }
+
+        bool isLastEdge() const {
+            return (value() & LAST_EDGE) != 0;
+        }
+
+        bool accepts() const {
+            return (value() & ACCEPT) != 0;
+        }
+
+        uint32_t children() const {
+            return value() >> CHILDREN_SHIFT;
+        }
     };
-#pragma pack()
-    Edge* edges;
-    Edge* start;
+    static_assert(sizeof(Edge) == 4, "an edge must be 4 bytes, as in the file");
+
+    const Edge* edges;
+    const Edge* start;
     int numEdges;
-    int numDawgWords;
+    mutable int numDawgWords;   // -1 until size counts the words of a binary file
     Set<std::string> otherWords;
+    void* mapping;          // mapped file that edges points into, or nullptr if edges is owned
+    size_t mappingSize;
+    ChildScan childScan;
 
 public:
     /*
@@ -415,8 +535,8 @@ public:
         std::string currentDawgPrefix;
         std::string currentSetWord;
         std::string tmpWord;
-        Edge* edgePtr;
-        Stack<Edge*> stack;
+        const Edge* edgePtr;
+        Stack<const Edge*> stack;
         Set<std::string>::iterator setIterator;
         Set<std::string>::iterator setEnd;
 
@@ -488,7 +608,7 @@ public:
                 return currentSetWord;
             }
             if (currentSetWord == "" || currentDawgPrefix < currentSetWord) {
-                return currentDawgPrefix + lp->ordToChar(edgePtr->letter);
+                return currentDawgPrefix + lp->ordToChar(edgePtr->letter());
             } else {
                 return currentSetWord;
             }
@@ -499,7 +619,7 @@ public:
                 return &currentSetWord;
             }
             if (currentSetWord == "" || currentDawgPrefix < currentSetWord) {
-                tmpWord = currentDawgPrefix + lp->ordToChar(edgePtr->letter);
+                tmpWord = currentDawgPrefix + lp->ordToChar(edgePtr->letter());
                 return &tmpWord;
             } else {
                 return &currentSetWord;
@@ -516,12 +636,23 @@ public:
     }
 
 private:
-    Edge* findEdgeForChar(Edge* children, char ch) const;
-    Edge* traceToLastEdge(const std::string& s) const;
+    /*
+     * Builds a minimal DAWG from words given in alphabetical order, in one
+     * pass; see dawglexicon.cpp.
+     */
+    class DawgBuilder;
+
+    const Edge* findEdgeForChar(const Edge* children, char ch) const;
+    static const Edge* findEdgeSse2(const Edge* children, const Edge* end, unsigned int ord);
+    static const Edge* findEdgeAvx2(const Edge* children, const Edge* end, unsigned int ord);
+    const Edge* traceToLastEdge(const std::string& s) const;
+    const Edge* traceFromEdge(const Edge* edge, const std::string& s, size_t from) const;
     void readBinaryFile(std::istream& input);
     void readBinaryFile(const std::string& filename);
+    void checkEdges(long startIndex);
+    void releaseEdges();
     void deepCopy(const DawgLexicon& src);
-    int countDawgWords(Edge* start) const;
+    int countDawgWords(uint32_t node, std::vector<int>& counts) const;
 
     unsigned int charToOrd(char ch) const {
         return ((unsigned int)(tolower(ch) - 'a' + 1));
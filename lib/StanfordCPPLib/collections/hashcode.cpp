@@ -3,16 +3,28 @@
  * ------------------
  * This file implements the interface declared in hashcode.h.
  * 
+ * @version 2026/10/18
+ * - added 64-bit word-at-a-time string hash, chosen by setStringHash
  * @version 2015/07/05
  * - using global hashing functions rather than global variables
  */
 
 #include "hashcode.h"
+#include <cstdint>
+#include <cstring>
 
 static const int HASH_SEED = 5381;               // Starting point for first cycle
 static const int HASH_MULTIPLIER = 33;           // Multiplier for each cycle
 static const int HASH_MASK = unsigned(-1) >> 1;  // All 1 bits except the sign
 
+// Constants of the word-at-a-time hash, the last two from the MurmurHash3 finalizer
+static const uint64_t WORD64_SEED = UINT64_C(0x9e3779b97f4a7c15);
+static const uint64_t WORD64_MULTIPLIER = UINT64_C(0x87c37b91114253d5);
+static const uint64_t WORD64_FINAL_1 = UINT64_C(0xff51afd7ed558ccd);
+static const uint64_t WORD64_FINAL_2 = UINT64_C(0xc4ceb9fe1a85ec53);
+
+static StringHash stringHash = WORD64_HASH;
+
 int hashSeed() {
     return HASH_SEED;
 }
@@ -72,22 +84,100 @@ int hashCode(long key) {
 }
 
 int hashCode(const char* str) {
-    unsigned hash = HASH_SEED;
-    for (int i = 0; str && str[i] != 0; i++) {
-        hash = HASH_MULTIPLIER * hash + str[i];
+    int length = str ? (int) strlen(str) : 0;
+    if (stringHash == DJB2_HASH) {
+        return hashCodeDjb2(str, length);
     }
-    return int(hash & HASH_MASK);
+    return hashCodeWord64(str, length);
 }
 
 int hashCode(const std::string& str) {
+    if (stringHash == DJB2_HASH) {
+        return hashCodeDjb2(str.data(), (int) str.length());
+    }
+    return hashCodeWord64(str.data(), (int) str.length());
+}
+
+int hashCode(void* key) {
+    return hashCode(reinterpret_cast<long>(key));
+}
+
+void setStringHash(StringHash hash) {
+    stringHash = hash;
+}
+
+StringHash getStringHash() {
+    return stringHash;
+}
+
+int hashCodeDjb2(const char* str, int length) {
     unsigned hash = HASH_SEED;
-    int n = str.length();
-    for (int i = 0; i < n; i++) {
+    for (int i = 0; i < length; i++) {
         hash = HASH_MULTIPLIER * hash + str[i];
     }
     return int(hash & HASH_MASK);
 }
 
-int hashCode(void* key) {
-    return hashCode(reinterpret_cast<long>(key));
+/*
+ * Implementation notes: hashCodeWord64
+ * ------------------------------------
+ * djb2 only carries each character into the bits above it, so short
+ * words that differ in their last letters differ only in their low bits.
+ * This hash reads the string 8 bytes at a time (with memcpy, which
+ * compiles to a single load and has no alignment requirement), and mixes
+ * each word into a 64-bit state with one multiply and a rotation.  Both
+ * can be undone, so strings that differ in only one word never reach the
+ * same state.  The bytes past the last full word are read with loads
+ * that overlap bytes already read rather than one at a time: the last
+ * 8 bytes of a longer string, the first and last 4 of a string of 4 to 7,
+ * and the first, middle and last byte of a shorter one.  The length is
+ * mixed in first, so that the overlap can't make two strings alike.
+ * A final round of multiplies and shifts from MurmurHash3 makes every
+ * input bit affect every output bit, and the top 31 bits of the state
+ * become the hash code.  The bytes are read in the machine's own order,
+ * so hash codes differ between little- and big-endian machines, which
+ * doesn't matter for tables in memory.
+ */
+
+static inline uint64_t readWord64(const char* bytes) {
+    uint64_t word;
+    memcpy(&word, bytes, 8);
+    return word;
+}
+
+static inline uint64_t readWord32(const char* bytes) {
+    uint32_t word;
+    memcpy(&word, bytes, 4);
+    return word;
+}
+
+static inline uint64_t mixWord64(uint64_t hash, uint64_t word) {
+    hash = (hash ^ word) * WORD64_MULTIPLIER;
+    return (hash << 31) | (hash >> 33);
+}
+
+int hashCodeWord64(const char* str, int length) {
+    uint64_t hash = mixWord64(WORD64_SEED, (uint64_t) length);
+    int i = 0;
+    for (; i + 8 <= length; i += 8) {
+        hash = mixWord64(hash, readWord64(str + i));
+    }
+    if (i < length) {
+        uint64_t word;
+        if (length >= 8) {
+            word = readWord64(str + length - 8);
+        } else if (length >= 4) {
+            word = readWord32(str) | readWord32(str + length - 4) << 32;
+        } else {
+            const unsigned char* bytes = (const unsigned char*) str;
+            word = bytes[0] | bytes[length / 2] << 8 | bytes[length - 1] << 16;
+        }
+        hash = mixWord64(hash, word);
+    }
+    hash ^= hash >> 33;
+    hash *= WORD64_FINAL_1;
+    hash ^= hash >> 33;
+    hash *= WORD64_FINAL_2;
+    hash ^= hash >> 33;
+    return int(hash >> 33);
 }
@@ -5,6 +5,9 @@
  * These functions are used by the HashMap and HashSet collections, as well as
  * by other collections that wish to be used as elements within HashMaps/Sets.
  * 
+ * @version 2026/10/18
+ * - strings are hashed 8 bytes at a time with 64-bit mixing by default;
+ *   the original djb2 string hash can be chosen with setStringHash
  * @version 2017/09/29
  * - added composite hashCode functions (hashCode2, 3, 4, ...)
  * @version 2015/07/05
@@ -35,6 +38,46 @@ int hashCode(const char* str);
 int hashCode(const std::string& str);
 int hashCode(void* key);
 
+/*
+ * Type: StringHash
+ * ----------------
+ * The ways <code>hashCode</code> can hash a string.  <code>DJB2_HASH</code>
+ * is the library's original hash, which takes one character at a time.
+ * <code>WORD64_HASH</code> takes 8 characters at a time and mixes them
+ * with 64-bit multiplies, so that every character of a word affects every
+ * bit of its hash code.
+ */
+enum StringHash { DJB2_HASH, WORD64_HASH };
+
+/*
+ * Function: setStringHash
+ * Usage: setStringHash(DJB2_HASH);
+ * --------------------------------
+ * Chooses how <code>hashCode</code> hashes strings.  The default is
+ * <code>WORD64_HASH</code>.  A HashMap or HashSet keeps the hash codes of
+ * its keys, so the string hash must only be changed while no hash
+ * collection holds strings, and not while other threads are hashing.
+ */
+void setStringHash(StringHash hash);
+
+/*
+ * Function: getStringHash
+ * Usage: StringHash hash = getStringHash();
+ * -----------------------------------------
+ * Returns how <code>hashCode</code> hashes strings.
+ */
+StringHash getStringHash();
+
+/*
+ * Function: hashCodeDjb2, hashCodeWord64
+ * Usage: int hash = hashCodeWord64(str.data(), str.length());
+ * -----------------------------------------------------------
+ * Returns the hash code of the given characters with one string hash,
+ * whichever is chosen, so that the two can be compared.
+ */
+int hashCodeDjb2(const char* str, int length);
+int hashCodeWord64(const char* str, int length);
+
 /*
  * Constants that are used to help implement these functions
  * (see hashcode.h for example usage)
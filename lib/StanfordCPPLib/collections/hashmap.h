@@ -4,6 +4,10 @@
  * This file exports the <code>HashMap</code> class, which stores
  * a set of <i>key</i>-<i>value</i> pairs.
  * 
+ * @version 2026/10/18
+ * - stored as an open-addressing table with Robin Hood probing, kept as parallel
+ *   arrays of probe lengths, hash codes, keys, and values; adding a key no longer
+ *   allocates a cell
  * @version 2016/10/14
  * - modified floating-point equality tests to use floatingPointEqual function
  * @version 2016/09/24
@@ -389,138 +393,208 @@ public:
     /*
      * Implementation notes:
      * ---------------------
-     * The HashMap class is represented using a hash table that uses
-     * bucket chaining to resolve collisions.
+     * The HashMap class is represented using an open-addressing hash table
+     * with Robin Hood probing.  Rather than an array of entries, the table
+     * is kept as parallel arrays of probe lengths, hash codes, keys, and
+     * values, so that a lookup runs over the small probe lengths and hash
+     * codes and only compares keys whose hash codes match.
     */
 private:
     /* Constant definitions */
-    static const int INITIAL_BUCKET_COUNT = 101;
+    static const int INITIAL_SLOT_COUNT = 16;   /* Must be a power of two */
     static const int MAX_LOAD_PERCENTAGE = 70;
-
-    /* Type definition for cells in the bucket chain */
-    struct Cell {
-        KeyType key;
-        ValueType value;
-        Cell* next;
-    };
+    static const int MAX_PROBE_LENGTH = 0xffff;
 
     /* Instance variables */
-    Vector<Cell*> buckets;
-    int nBuckets;
+    unsigned short* probeLengths;   /* 0 if empty, else 1 + distance from home slot */
+    unsigned int* slotHashes;       /* Hash code of the key in each slot             */
+    KeyType* slotKeys;              /* Key in each slot                              */
+    ValueType* slotValues;          /* Value in each slot                            */
+    int nSlots;                     /* 0 or a power of two                           */
+    int slotShift;                  /* Shift that turns a hash code into a slot      */
     int numEntries;
 
     /* Private methods */
 
     /*
-     * Private method: createBuckets
-     * Usage: createBuckets(nBuckets);
-     * -------------------------------
-     * Sets up the vector of buckets to have nBuckets entries, each null.
-     * If asked to make empty vector, makes one bucket just to simplify
-     * handling elsewhere.
+     * Private method: createSlots
+     * Usage: createSlots(nSlots);
+     * ---------------------------
+     * Allocates nSlots empty slots, which must be 0 or a power of two.
+     * With 0 slots nothing is allocated until the first key is added.
      */
-    void createBuckets(int nBuckets) {
-        if (nBuckets == 0) {
-            nBuckets = 1;
+    void createSlots(int nSlots) {
+        this->nSlots = nSlots;
+        slotShift = 32;
+        for (int n = nSlots; n > 1; n /= 2) {
+            slotShift--;
+        }
+        if (nSlots == 0) {
+            probeLengths = nullptr;
+            slotHashes = nullptr;
+            slotKeys = nullptr;
+            slotValues = nullptr;
+        } else {
+            probeLengths = new unsigned short[nSlots]();
+            slotHashes = new unsigned int[nSlots];
+            slotKeys = new KeyType[nSlots];
+            slotValues = new ValueType[nSlots];
         }
-        buckets = Vector<Cell*>(nBuckets, nullptr);
-        this->nBuckets = nBuckets;
         numEntries = 0;
     }
 
     /*
-     * Private method: deleteBuckets
-     * Usage: deleteBuckets(buckets);
-     * ------------------------------
-     * Deletes all the cells in the linked lists contained in vector.
+     * Private method: deleteSlots
+     * Usage: deleteSlots();
+     * ---------------------
+     * Frees the arrays that make up the slots.
      */
-    void deleteBuckets(Vector<Cell*>& buckets) {
-        for (int i = 0; i < buckets.size(); i++) {
-            Cell* cp = buckets[i];
-            while (cp) {
-                Cell* np = cp->next;
-                delete cp;
-                cp = np;
-            }
-            buckets[i] = nullptr;
-        }
+    void deleteSlots() {
+        delete[] probeLengths;
+        delete[] slotHashes;
+        delete[] slotKeys;
+        delete[] slotValues;
+    }
+
+    /*
+     * Private method: homeSlot
+     * Usage: int slot = homeSlot(hash);
+     * ---------------------------------
+     * Returns the slot where a key with the given hash code is looked for
+     * first.  The hash code is multiplied by 2^32 divided by the golden
+     * ratio and the top bits are kept.  The multiply carries differences in
+     * the low bits up into those top bits, so that hash codes which differ
+     * only in their low bits, such as those of small integers, still spread
+     * out over the table.
+     */
+    int homeSlot(unsigned int hash) const {
+        return int((hash * 2654435769u) >> slotShift);
     }
 
     /*
      * Private method: expandAndRehash
      * Usage: expandAndRehash();
      * -------------------------
-     * This method is used to increase the number of buckets in the map
-     * and then rehashes all existing entries and adds them into new buckets.
-     * This operation is used when the load factor (i.e. the number of cells
-     * per bucket) has increased enough to warrant this O(N) operation to
-     * enlarge and redistribute the entries.
+     * This method is used to double the number of slots in the map and
+     * then moves all existing entries into the new slots.  The stored hash
+     * codes are reused, so no key is hashed again.
      */
     void expandAndRehash() {
-        Vector<Cell*> oldBuckets = buckets;
-        createBuckets(oldBuckets.size() * 2 + 1);
-        for (int i = 0; i < oldBuckets.size(); i++) {
-            for (Cell* cp = oldBuckets[i]; cp != nullptr; cp = cp->next) {
-                put(cp->key, cp->value);
+        unsigned short* oldProbeLengths = probeLengths;
+        unsigned int* oldHashes = slotHashes;
+        KeyType* oldKeys = slotKeys;
+        ValueType* oldValues = slotValues;
+        int oldSlots = nSlots;
+        createSlots(oldSlots == 0 ? INITIAL_SLOT_COUNT : oldSlots * 2);
+        for (int i = 0; i < oldSlots; i++) {
+            if (oldProbeLengths[i] != 0) {
+                insertSlot(oldHashes[i], std::move(oldKeys[i]), std::move(oldValues[i]));
             }
         }
-        deleteBuckets(oldBuckets);
+        delete[] oldProbeLengths;
+        delete[] oldHashes;
+        delete[] oldKeys;
+        delete[] oldValues;
     }
 
     /*
-     * Private method: findCell
-     * Usage: Cell* cp = findCell(bucket, key);
-     *        Cell* cp = findCell(bucket, key, parent);
-     * ------------------------------------------------
-     * Finds a cell in the chain for the specified bucket that matches key.
-     * If a match is found, the return value is a pointer to the cell containing
-     * the matching key.  If no match is found, the function returns nullptr.
-     * If the optional third argument is supplied, it is filled in with the
-     * cell preceding the matching cell to allow the client to splice out
-     * the target cell in the delete call.  If parent is null, it indicates
-     * that the cell is the first cell in the bucket chain.
-     */
-    Cell* findCell(int bucket, const KeyType& key) const {
-        Cell *dummy;
-        return findCell(bucket, key, dummy);
+     * Private method: findSlot
+     * Usage: int slot = findSlot(key, hash);
+     * --------------------------------------
+     * Finds the slot holding the given key, whose hash code is hash.
+     * Robin Hood probing keeps each run of slots sorted by distance from
+     * home, so the search can stop at the first slot whose entry is closer
+     * to its home than the key would be.  If no match is found, the
+     * function returns -1.
+     */
+    int findSlot(const KeyType& key, unsigned int hash) const {
+        if (numEntries == 0) {
+            return -1;
+        }
+        int slot = homeSlot(hash);
+        for (int probe = 1; probeLengths[slot] >= probe; probe++) {
+            if (slotHashes[slot] == hash && key == slotKeys[slot]) {
+                return slot;
+            }
+            slot = (slot + 1) & (nSlots - 1);
+        }
+        return -1;
+    }
+
+    /*
+     * Private method: insertSlot
+     * Usage: int slot = insertSlot(hash, key, value);
+     * -----------------------------------------------
+     * Adds a key that is not yet in the map, which must have room for it.
+     * Whenever the entry being placed is further from its home slot than
+     * the one in its way, the two swap places and the displaced entry is
+     * carried on instead.  Returns the slot where the given key ends up.
+     */
+    int insertSlot(unsigned int hash, KeyType key, ValueType value) {
+        int placed = -1;
+        int slot = homeSlot(hash);
+        for (int probe = 1; ; probe++) {
+            if (probe > MAX_PROBE_LENGTH) {
+                error("HashMap: too many keys with the same hash code");
+            }
+            if (probeLengths[slot] == 0) {
+                probeLengths[slot] = (unsigned short) probe;
+                slotHashes[slot] = hash;
+                slotKeys[slot] = std::move(key);
+                slotValues[slot] = std::move(value);
+                numEntries++;
+                return placed == -1 ? slot : placed;
+            }
+            if (probeLengths[slot] < probe) {
+                int displaced = probeLengths[slot];
+                probeLengths[slot] = (unsigned short) probe;
+                probe = displaced;
+                std::swap(slotHashes[slot], hash);
+                std::swap(slotKeys[slot], key);
+                std::swap(slotValues[slot], value);
+                if (placed == -1) {
+                    placed = slot;
+                }
+            }
+            slot = (slot + 1) & (nSlots - 1);
+        }
     }
 
-    Cell* findCell(int bucket, const KeyType& key, Cell*& parent) const {
-        parent = nullptr;
-        Cell* cp = buckets.get(bucket);
-        while (cp && !(key == cp->key)) {
-            parent = cp;
-            cp = cp->next;
+    /*
+     * Private method: removeSlot
+     * Usage: removeSlot(slot);
+     * ------------------------
+     * Empties the given slot and shifts the entries after it back by one
+     * until one is in its home slot, so no tombstones are left behind.
+     */
+    void removeSlot(int slot) {
+        int next = (slot + 1) & (nSlots - 1);
+        while (probeLengths[next] > 1) {
+            probeLengths[slot] = (unsigned short) (probeLengths[next] - 1);
+            slotHashes[slot] = slotHashes[next];
+            slotKeys[slot] = std::move(slotKeys[next]);
+            slotValues[slot] = std::move(slotValues[next]);
+            slot = next;
+            next = (next + 1) & (nSlots - 1);
         }
-        return cp;
+        probeLengths[slot] = 0;
+        slotKeys[slot] = KeyType();
+        slotValues[slot] = ValueType();
+        numEntries--;
     }
 
     void deepCopy(const HashMap& src) {
-        createBuckets(src.nBuckets);
-        for (int i = 0; i < src.nBuckets; i++) {
-            // BUGFIX: was just calling put(), which reversed the chains;
-            // now deep-copy the chains exactly as they were to preserve hashcode
-            Cell* endOfChain = nullptr;
-            for (Cell* cp = src.buckets.get(i); cp != nullptr; cp = cp->next) {
-                // put(cp->key, cp->value);
-                
-                // copy the cell and put at end of bucket list
-                Cell* copy = new Cell();
-                copy->key = cp->key;
-                copy->value = cp->value;
-                copy->next = nullptr;
-                if (!endOfChain) {
-                    // first node in bucket
-                    buckets.set(i, copy);
-                } else {
-                    // not first node; put after existing node
-                    endOfChain->next = copy;
-                    endOfChain = copy;
-                }
-                endOfChain = copy;
-                numEntries++;
+        // copy the slots exactly as they are, so the copy iterates in the same order
+        createSlots(src.nSlots);
+        for (int i = 0; i < nSlots; i++) {
+            probeLengths[i] = src.probeLengths[i];
+            if (probeLengths[i] != 0) {
+                slotHashes[i] = src.slotHashes[i];
+                slotKeys[i] = src.slotKeys[i];
+                slotValues[i] = src.slotValues[i];
             }
         }
+        numEntries = src.numEntries;
     }
 
 public:
@@ -542,7 +616,7 @@ public:
      */
     HashMap& operator =(const HashMap& src) {
         if (this != &src) {
-            clear();
+            deleteSlots();
             deepCopy(src);
         }
         return *this;
@@ -561,40 +635,34 @@ public:
      */
     class iterator : public std::iterator<std::input_iterator_tag, KeyType> {
     private:
-        const HashMap* mp;           /* Pointer to the map           */
-        int bucket;                  /* Index of current bucket      */
-        Cell* cp;                    /* Current cell in bucket chain */
+        const HashMap* mp;           /* Pointer to the map       */
+        int slot;                    /* Index of the current slot */
+
+        void skipEmptySlots() {
+            while (slot < mp->nSlots && mp->probeLengths[slot] == 0) {
+                slot++;
+            }
+        }
 
     public:
-        iterator() : mp(nullptr), bucket(0), cp(nullptr) {
+        iterator() : mp(nullptr), slot(0) {
             /* Empty */
         }
 
         iterator(const HashMap* mp, bool end) {
             this->mp = mp;
-            if (end) {
-                bucket = mp->nBuckets;
-                cp = nullptr;
-            } else {
-                bucket = 0;
-                cp = mp->buckets.get(bucket);
-                while (!cp && ++bucket < mp->nBuckets) {
-                    cp = mp->buckets.get(bucket);
-                }
-            }
+            slot = end ? mp->nSlots : 0;
+            skipEmptySlots();
         }
 
         iterator(const iterator& it) {
             mp = it.mp;
-            bucket = it.bucket;
-            cp = it.cp;
+            slot = it.slot;
         }
 
         iterator& operator ++() {
-            cp = cp->next;
-            while (!cp && ++bucket < mp->nBuckets) {
-                cp = mp->buckets.get(bucket);
-            }
+            slot++;
+            skipEmptySlots();
             return *this;
         }
 
@@ -605,7 +673,7 @@ public:
         }
 
         bool operator ==(const iterator& rhs) {
-            return mp == rhs.mp && bucket == rhs.bucket && cp == rhs.cp;
+            return mp == rhs.mp && slot == rhs.slot;
         }
 
         bool operator !=(const iterator& rhs) {
@@ -613,11 +681,11 @@ public:
         }
 
         KeyType& operator *() {
-            return cp->key;
+            return mp->slotKeys[slot];
         }
 
         KeyType* operator ->() {
-            return &cp->key;
+            return &mp->slotKeys[slot];
         }
 
         friend class HashMap;
@@ -641,28 +709,29 @@ public:
 /*
  * Implementation notes: HashMap class
  * -----------------------------------
- * In this map implementation, the entries are stored in a hashtable.
- * The hashtable keeps a vector of "buckets", where each bucket is a
- * linked list of elements that share the same hash code (i.e. hash
- * collisions are resolved by chaining). The buckets are dynamically
- * allocated so that we can change the the number of buckets (rehash)
- * when the load factor becomes too high. The map should provide O(1)
- * performance on the put/remove/get operations.
+ * In this map implementation, the entries are stored in a hashtable
+ * that resolves collisions by open addressing: a key that finds its
+ * home slot taken goes in the next free slot after it.  Robin Hood
+ * probing lets an entry take the slot of one that is closer to its own
+ * home, which keeps every key within a few slots of its home.  Adding
+ * a key therefore allocates nothing except when the slots are doubled
+ * (rehash) because the load factor has become too high.  The map should
+ * provide O(1) performance on the put/remove/get operations.
  */
 template <typename KeyType, typename ValueType>
 HashMap<KeyType, ValueType>::HashMap() {
-    createBuckets(INITIAL_BUCKET_COUNT);
+    createSlots(0);
 }
 
 template <typename KeyType, typename ValueType>
 HashMap<KeyType, ValueType>::HashMap(std::initializer_list<std::pair<KeyType, ValueType> > list) {
-    createBuckets(INITIAL_BUCKET_COUNT);
+    createSlots(0);
     putAll(list);
 }
 
 template <typename KeyType, typename ValueType>
 HashMap<KeyType, ValueType>::~HashMap() {
-    deleteBuckets(buckets);
+    deleteSlots();
     numEntries = 0;
 }
 
@@ -684,13 +753,20 @@ HashMap<KeyType, ValueType>& HashMap<KeyType, ValueType>::addAll(
 
 template <typename KeyType, typename ValueType>
 void HashMap<KeyType, ValueType>::clear() {
-    deleteBuckets(buckets);
+    // keep the slots, so a map that is cleared and filled again allocates nothing
+    for (int i = 0; i < nSlots; i++) {
+        if (probeLengths[i] != 0) {
+            probeLengths[i] = 0;
+            slotKeys[i] = KeyType();
+            slotValues[i] = ValueType();
+        }
+    }
     numEntries = 0;
 }
 
 template <typename KeyType, typename ValueType>
 bool HashMap<KeyType, ValueType>::containsKey(const KeyType& key) const {
-    return findCell(hashCode(key) % nBuckets, key) != nullptr;
+    return findSlot(key, hashCode(key)) != -1;
 }
 
 template <typename KeyType, typename ValueType>
@@ -700,11 +776,11 @@ bool HashMap<KeyType, ValueType>::equals(const HashMap<KeyType, ValueType>& map2
 
 template <typename KeyType, typename ValueType>
 ValueType HashMap<KeyType, ValueType>::get(const KeyType& key) const {
-    Cell* cp = findCell(hashCode(key) % nBuckets, key);
-    if (!cp) {
+    int slot = findSlot(key, hashCode(key));
+    if (slot == -1) {
         return ValueType();
     }
-    return cp->value;
+    return slotValues[slot];
 }
 
 template <typename KeyType, typename ValueType>
@@ -723,9 +799,9 @@ Vector<KeyType> HashMap<KeyType, ValueType>::keys() const {
 
 template <typename KeyType, typename ValueType>
 void HashMap<KeyType, ValueType>::mapAll(void (*fn)(KeyType, ValueType)) const {
-    for (int i = 0; i < buckets.size(); i++) {
-        for (Cell* cp = buckets.get(i); cp != nullptr; cp = cp->next) {
-            fn(cp->key, cp->value);
+    for (int i = 0; i < nSlots; i++) {
+        if (probeLengths[i] != 0) {
+            fn(slotKeys[i], slotValues[i]);
         }
     }
 }
@@ -733,9 +809,9 @@ void HashMap<KeyType, ValueType>::mapAll(void (*fn)(KeyType, ValueType)) const {
 template <typename KeyType, typename ValueType>
 void HashMap<KeyType, ValueType>::mapAll(void (*fn)(const KeyType&,
                                                    const ValueType&)) const {
-    for (int i = 0; i < buckets.size(); i++) {
-        for (Cell* cp = buckets.get(i); cp != nullptr; cp = cp->next) {
-            fn(cp->key, cp->value);
+    for (int i = 0; i < nSlots; i++) {
+        if (probeLengths[i] != 0) {
+            fn(slotKeys[i], slotValues[i]);
         }
     }
 }
@@ -743,9 +819,9 @@ void HashMap<KeyType, ValueType>::mapAll(void (*fn)(const KeyType&,
 template <typename KeyType, typename ValueType>
 template <typename FunctorType>
 void HashMap<KeyType, ValueType>::mapAll(FunctorType fn) const {
-    for (int i = 0; i < buckets.size(); i++) {
-        for (Cell* cp = buckets.get(i); cp != nullptr; cp = cp->next) {
-            fn(cp->key, cp->value);
+    for (int i = 0; i < nSlots; i++) {
+        if (probeLengths[i] != 0) {
+            fn(slotKeys[i], slotValues[i]);
         }
     }
 }
@@ -774,17 +850,9 @@ HashMap<KeyType, ValueType>& HashMap<KeyType, ValueType>::putAll(
 
 template <typename KeyType, typename ValueType>
 void HashMap<KeyType, ValueType>::remove(const KeyType& key) {
-    int bucket = hashCode(key) % nBuckets;
-    Cell *parent;
-    Cell* cp = findCell(bucket, key, parent);
-    if (cp) {
-        if (!parent) {
-            buckets[bucket] = cp->next;
-        } else {
-            parent->next = cp->next;
-        }
-        delete cp;
-        numEntries--;
+    int slot = findSlot(key, hashCode(key));
+    if (slot != -1) {
+        removeSlot(slot);
     }
 }
 
@@ -854,21 +922,15 @@ Vector<ValueType> HashMap<KeyType, ValueType>::values() const {
 
 template <typename KeyType, typename ValueType>
 ValueType& HashMap<KeyType, ValueType>::operator [](const KeyType& key) {
-    int bucket = hashCode(key) % nBuckets;
-    Cell* cp = findCell(bucket, key);
-    if (!cp) {
-        if (numEntries > MAX_LOAD_PERCENTAGE * nBuckets / 100.0) {
+    unsigned int hash = hashCode(key);
+    int slot = findSlot(key, hash);
+    if (slot == -1) {
+        if (numEntries >= MAX_LOAD_PERCENTAGE * nSlots / 100.0) {
             expandAndRehash();
-            bucket = hashCode(key) % nBuckets;
         }
-        cp = new Cell;
-        cp->key = key;
-        cp->value = ValueType();
-        cp->next = buckets[bucket];
-        buckets[bucket] = cp;
-        numEntries++;
+        slot = insertSlot(hash, key, ValueType());
     }
-    return cp->value;
+    return slotValues[slot];
 }
 
 template <typename KeyType, typename ValueType>
@@ -4,6 +4,8 @@
  * This file exports the <code>HashSet</code> class, which
  * implements an efficient abstraction for storing sets of values.
  * 
+ * @version 2026/10/18
+ * - backed by the open-addressing HashMap, so adding an element no longer allocates
  * @version 2016/12/06
  * - slight speedup bug fix in equals() method
  * @version 2016/09/24
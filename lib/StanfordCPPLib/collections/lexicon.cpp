@@ -15,6 +15,15 @@
  *
  * The original DAWG implementation is retained as dawglexicon.h/cpp.
  * 
+ * @version 2026/10/18
+ * - trie nodes stored in one array and linked by 32-bit index instead of pointer;
+ *   add/contains/remove walk the trie with loops instead of recursion
+ * - removed the Set of all words; iteration, first, toString and copying
+ *   walk the trie depth-first, which visits the words in alphabetical order
+ * - files whose words are in alphabetical order are loaded by TrieBuilder
+ *   in one pass, with each node's children written out once
+ * - added containsBatch, which walks a prefix shared with the word before
+ *   once, and neighborsAt, which tries only the letters the trie has
  * @version 2016/09/24
  * - refactored to use collections.h utility functions
  * @version 2016/08/11
@@ -47,39 +56,133 @@
 #include "filelib.h"
 #include "hashcode.h"
 #include "strlib.h"
+#include "vector.h"
 
 static bool scrub(std::string& str);
 
+/*
+ * TrieBuilder lays the trie out while reading words in alphabetical order.
+ * Only the nodes on the path to the last word can still gain children, so
+ * the children of each of those nodes are collected in m_levels; when a
+ * word leaves a node's subtree for good, its children are appended to the
+ * node array as one block.  Every block is written exactly once, so the
+ * trie ends up as compact as Lexicon::compact would make it.
+ */
+class Lexicon::TrieBuilder {
+public:
+    // pre: lex is empty
+    TrieBuilder(Lexicon& lex) : m_lex(lex), m_finished(false) {
+        m_lex.m_nodes.push_back(TrieNode());   // the root's place; written by finish
+    }
+
+    // pre: word is scrubbed to contain only lowercase a-z letters
+    // returns false, without adding the word, if it comes before the last one
+    bool add(const std::string& word) {
+        if (word < m_lastWord) {
+            return false;
+        } else if (word == m_lastWord) {
+            return true;   // duplicate word; already present
+        }
+
+        // the nodes below the prefix shared with the last word are complete
+        size_t shared = 0;
+        while (shared < m_lastWord.length() && m_lastWord[shared] == word[shared]) {
+            shared++;
+        }
+        closeLevels(shared);
+
+        // one new node for each remaining letter
+        if (m_levels.size() < word.length()) {
+            m_levels.resize(word.length());
+        }
+        for (size_t depth = shared; depth < word.length(); depth++) {
+            nodeAt(depth).m_letters |= 1u << (word[depth] - 'a');
+            m_levels[depth].push_back(TrieNode());
+        }
+        nodeAt(word.length()).setWord(true);
+        m_lex.m_size++;
+        m_lastWord = word;
+        return true;
+    }
+
+    // writes out the nodes still being collected; no more words can be added
+    void finish() {
+        if (m_finished) {
+            return;
+        }
+        m_finished = true;
+        closeLevels(0);
+        if (!m_levels.empty() && !m_levels[0].empty()) {
+            m_root.m_firstChild = m_lex.m_nodes.size();
+            appendLevel(0);
+        }
+        m_lex.m_nodes[0] = m_root;
+        if (m_lex.m_size == 0) {
+            m_lex.m_nodes.clear();
+        }
+    }
+
+private:
+    // the node at the given depth on the path to the last word
+    TrieNode& nodeAt(size_t depth) {
+        return depth == 0 ? m_root : m_levels[depth - 1].back();
+    }
+
+    // writes out the children of the nodes deeper than the given depth on
+    // the path to the last word, from the bottom up
+    void closeLevels(size_t depth) {
+        for (size_t level = m_lastWord.length(); level > depth; level--) {
+            if (level < m_levels.size() && !m_levels[level].empty()) {
+                nodeAt(level).m_firstChild = m_lex.m_nodes.size();
+                appendLevel(level);
+            }
+        }
+    }
+
+    void appendLevel(size_t level) {
+        m_lex.m_nodes.insert(m_lex.m_nodes.end(), m_levels[level].begin(), m_levels[level].end());
+        m_levels[level].clear();
+    }
+
+    /* instance variables */
+    Lexicon& m_lex;
+    TrieNode m_root;
+    std::vector<std::vector<TrieNode> > m_levels;   // m_levels[d] holds the children collected
+                                                    // so far for the node at depth d
+    std::string m_lastWord;
+    bool m_finished;
+};
+
 Lexicon::Lexicon() :
-        m_root(nullptr),
+        m_unusedNodes(0),
         m_size(0),
         m_removeFlag(false) {
     // empty
 }
 
 Lexicon::Lexicon(std::istream& input) :
-        m_root(nullptr),
+        m_unusedNodes(0),
         m_size(0),
         m_removeFlag(false) {
     addWordsFromFile(input);
 }
 
 Lexicon::Lexicon(const std::string& filename) :
-        m_root(nullptr),
+        m_unusedNodes(0),
         m_size(0),
         m_removeFlag(false) {
     addWordsFromFile(filename);
 }
 
 Lexicon::Lexicon(std::initializer_list<std::string> list) :
-        m_root(nullptr),
+        m_unusedNodes(0),
         m_size(0),
         m_removeFlag(false) {
     addAll(list);
 }
 
 Lexicon::Lexicon(const Lexicon& src) :
-        m_root(nullptr),
+        m_unusedNodes(0),
         m_size(0),
         m_removeFlag(false) {
     deepCopy(src);
@@ -97,7 +200,7 @@ bool Lexicon::add(const std::string& word) {
     if (!scrub(scrubbed)) {
         return false;
     }
-    return addHelper(m_root, scrubbed, /* originalWord */ scrubbed);
+    return addHelper(scrubbed);
 }
 
 Lexicon& Lexicon::addAll(const Lexicon& lex) {
@@ -124,6 +227,19 @@ void Lexicon::addWordsFromFile(std::istream& input) {
             error("Lexicon::addWordsFromFile: Couldn't read from input");
         }
         std::string line;
+        if (isEmpty()) {
+            TrieBuilder builder(*this);
+            while (getline(input, line)) {
+                std::string word = trim(line);
+                if (!word.empty() && scrub(word) && !builder.add(word)) {
+                    // out of order; the rest of the file is added one word at a time
+                    builder.finish();
+                    add(word);
+                    break;
+                }
+            }
+            builder.finish();
+        }
         while (getline(input, line)) {
             add(trim(line));
         }
@@ -141,9 +257,8 @@ void Lexicon::addWordsFromFile(const std::string& filename) {
 
 void Lexicon::clear() {
     m_size = 0;
-    m_allWords.clear();
-    deleteTree(m_root);
-    m_root = nullptr;
+    m_nodes.clear();
+    m_unusedNodes = 0;
 }
 
 bool Lexicon::contains(const std::string& word) const {
@@ -154,7 +269,7 @@ bool Lexicon::contains(const std::string& word) const {
     if (!scrub(scrubbed)) {
         return false;
     }
-    return containsHelper(m_root, scrubbed, /* isPrefix */ false);
+    return containsHelper(scrubbed, /* isPrefix */ false);
 }
 
 bool Lexicon::containsAll(const Lexicon& lex2) const {
@@ -175,6 +290,41 @@ bool Lexicon::containsAll(std::initializer_list<std::string> list) const {
     return true;
 }
 
+std::vector<bool> Lexicon::containsBatch(const std::vector<std::string>& words) const {
+    std::vector<bool> result(words.size(), false);
+    if (m_nodes.empty()) {
+        return result;
+    }
+    // path[d] is the node reached by the first d letters of the last walk,
+    // which spelled out the letters in walked
+    std::vector<uint32_t> path(1, 0);
+    std::string walked;
+    for (size_t k = 0; k < words.size(); k++) {
+        std::string scrubbed = words[k];
+        if (scrubbed.empty() || !scrub(scrubbed)) {
+            continue;
+        }
+        size_t shared = 0;
+        while (shared < walked.length() && shared < scrubbed.length()
+               && walked[shared] == scrubbed[shared]) {
+            shared++;
+        }
+        path.resize(shared + 1);
+        walked.resize(shared);
+        while (walked.length() < scrubbed.length()) {
+            const TrieNode& current = m_nodes[path.back()];
+            char letter = scrubbed[walked.length()];
+            if (!current.hasChild(letter)) {
+                break;
+            }
+            path.push_back(current.child(letter));
+            walked.push_back(letter);
+        }
+        result[k] = walked.length() == scrubbed.length() && m_nodes[path.back()].isWord();
+    }
+    return result;
+}
+
 bool Lexicon::containsPrefix(const std::string& prefix) const {
     if (prefix.empty()) {
         return true;
@@ -183,7 +333,7 @@ bool Lexicon::containsPrefix(const std::string& prefix) const {
     if (!scrub(scrubbed)) {
         return false;
     }
-    return containsHelper(m_root, scrubbed, /* isPrefix */ true);
+    return containsHelper(scrubbed, /* isPrefix */ true);
 }
 
 bool Lexicon::equals(const Lexicon& lex2) const {
@@ -194,7 +344,7 @@ std::string Lexicon::first() const {
     if (isEmpty()) {
         error("Lexicon::first: lexicon is empty");
     }
-    return m_allWords.first();
+    return *begin();
 }
 
 void Lexicon::insert(const std::string& word) {
@@ -231,17 +381,42 @@ bool Lexicon::isSupersetOf(std::initializer_list<std::string> list) const {
 }
 
 void Lexicon::mapAll(void (*fn)(std::string)) const {
-    for (std::string word : m_allWords) {
+    for (const std::string& word : *this) {
         fn(word);
     }
 }
 
 void Lexicon::mapAll(void (*fn)(const std::string&)) const {
-    for (std::string word : m_allWords) {
+    for (const std::string& word : *this) {
         fn(word);
     }
 }
 
+std::vector<std::string> Lexicon::neighborsAt(const std::string& word, int i) const {
+    std::vector<std::string> result;
+    std::string scrubbed = word;
+    if (i < 0 || i >= (int) word.length() || !scrub(scrubbed)) {
+        return result;
+    }
+    int parent = findNode(scrubbed.substr(0, i));
+    if (parent == -1) {
+        return result;
+    }
+    const TrieNode& node = m_nodes[parent];
+    char original = scrubbed[i];
+    for (char letter = 'a'; letter <= 'z'; letter++) {
+        if (letter == original || !node.hasChild(letter)) {
+            continue;
+        }
+        int found = findNode(node.child(letter), scrubbed, i + 1);
+        if (found != -1 && m_nodes[found].isWord()) {
+            scrubbed[i] = letter;
+            result.push_back(scrubbed);
+        }
+    }
+    return result;
+}
+
 bool Lexicon::remove(const std::string& word) {
     if (word.empty()) {
         return false;
@@ -250,7 +425,7 @@ bool Lexicon::remove(const std::string& word) {
     if (!scrub(scrubbed)) {
         return false;
     }
-    return removeHelper(m_root, scrubbed, /* originalWord */ scrubbed, /* isPrefix */ false);
+    return removeHelper(scrubbed, /* isPrefix */ false);
 }
 
 Lexicon& Lexicon::removeAll(const Lexicon& lex2) {
@@ -284,7 +459,7 @@ bool Lexicon::removePrefix(const std::string& prefix) {
         return false;
     }
     
-    return removeHelper(m_root, scrubbed, /* originalWord */ scrubbed, /* isPrefix */ true);
+    return removeHelper(scrubbed, /* isPrefix */ true);
 }
 
 Lexicon& Lexicon::retainAll(const Lexicon& lex2) {
@@ -311,7 +486,7 @@ int Lexicon::size() const {
 
 std::set<std::string> Lexicon::toStlSet() const {
     std::set<std::string> result;
-    for (const std::string& word : m_allWords) {
+    for (const std::string& word : *this) {
         result.insert(word);
     }
     return result;
@@ -442,120 +617,181 @@ Lexicon& Lexicon::operator ,(const std::string& word) {
 }
 
 // pre: word is scrubbed to contain only lowercase a-z letters
-bool Lexicon::addHelper(TrieNode*& node, const std::string& word, const std::string& originalWord) {
-    if (!node) {
-        // create nodes all the way down, one for each letter of the word
-        node = new TrieNode();
+bool Lexicon::addHelper(const std::string& word) {
+    if (m_nodes.empty()) {
+        m_nodes.push_back(TrieNode());   // the root
     }
 
-    if (word.empty()) {
-        // base case: we have added all of the letters of this word
-        if (node->isWord()) {
-            return false;   // duplicate word; already present
+    // follow the letters of the word, creating nodes for any that are missing
+    uint32_t node = 0;
+    for (char letter : word) {
+        if (m_nodes[node].hasChild(letter)) {
+            node = m_nodes[node].child(letter);
         } else {
-            // new word; add it
-            node->setWord(true);
-            m_size++;
-            m_allWords.add(originalWord);
-            return true;
+            node = addChild(node, letter);
         }
-    } else {
-        // recursive case: chop off first letter, traverse the rest
-        return addHelper(node->child(word[0]), word.substr(1), originalWord);
     }
+    if (m_nodes[node].isWord()) {
+        return false;   // duplicate word; already present
+    }
+    // new word; add it
+    m_nodes[node].setWord(true);
+    m_size++;
+    if (m_unusedNodes > (int) m_nodes.size() / 2) {
+        compact();
+    }
+    return true;
+}
+
+// pre: node has no child for the letter
+// moves the node's children to a new block at the end of m_nodes, with room
+// for the new child in letter order, and returns the new child's index
+uint32_t Lexicon::addChild(uint32_t node, char letter) {
+    uint32_t oldFirst = m_nodes[node].m_firstChild;
+    int count = m_nodes[node].childCount();
+    uint32_t slot = m_nodes[node].child(letter) - oldFirst;   // children before the new one
+    uint32_t newFirst = m_nodes.size();
+    m_nodes.resize(newFirst + count + 1);
+    for (uint32_t i = 0; i < (uint32_t) count; i++) {
+        m_nodes[newFirst + i + (i >= slot ? 1 : 0)] = m_nodes[oldFirst + i];
+    }
+    m_nodes[node].m_letters |= 1u << (letter - 'a');
+    m_nodes[node].m_firstChild = newFirst;
+    m_unusedNodes += count;
+    return newFirst + slot;
+}
+
+// pre: node has a child for the letter, and that child has no children
+// removes the child; later siblings move down over it
+void Lexicon::removeChild(uint32_t node, char letter) {
+    uint32_t child = m_nodes[node].child(letter);
+    uint32_t end = m_nodes[node].m_firstChild + m_nodes[node].childCount();
+    for (uint32_t i = child; i + 1 < end; i++) {
+        m_nodes[i] = m_nodes[i + 1];
+    }
+    m_nodes[node].m_letters &= ~(1u << (letter - 'a'));
+    m_unusedNodes++;
+}
+
+/*
+ * Copies the nodes still reachable from the root to a new array, in
+ * breadth-first order, which keeps each node's children in one block
+ * and drops the nodes left unused by adding and removing words.
+ */
+void Lexicon::compact() {
+    std::vector<TrieNode> nodes;
+    nodes.reserve(m_nodes.size() - m_unusedNodes);
+    nodes.push_back(m_nodes[0]);
+    for (uint32_t node = 0; node < nodes.size(); node++) {
+        uint32_t oldFirst = nodes[node].m_firstChild;
+        int count = nodes[node].childCount();
+        nodes[node].m_firstChild = nodes.size();
+        for (int i = 0; i < count; i++) {
+            nodes.push_back(m_nodes[oldFirst + i]);
+        }
+    }
+    m_nodes.swap(nodes);
+    m_unusedNodes = 0;
 }
 
 // pre: word is scrubbed to contain only lowercase a-z letters
-bool Lexicon::containsHelper(TrieNode* node, const std::string& word, bool isPrefix) const {
-    if (!node) {
-        // base case: no pointer down to here, so prefix must not exist
-        return false;
-    } else if (word.length() == 0) {
-        // base case: Found nodes all the way down.
-        // If we are looking for a prefix, this means this path IS a prefix,
-        // so we should return true.
-        // If we are looking for an exact word match rather than a prefix,
-        // we must check the isWord flag to see that this word was added
-        return (isPrefix ? true : node->isWord());
-    } else {
-        // recursive case: follow appropriate child pointer for one letter
-        return containsHelper(node->child(word[0]), word.substr(1), isPrefix);
+// returns the index of the node the word leads to, or -1 if there is none
+int Lexicon::findNode(const std::string& word) const {
+    if (m_nodes.empty()) {
+        return -1;
     }
+    return findNode(0, word, 0);
 }
 
 // pre: word is scrubbed to contain only lowercase a-z letters
-bool Lexicon::removeHelper(TrieNode*& node, const std::string& word, const std::string& originalWord, bool isPrefix) {
-    if (!node) {
-        // base case: dead end; this word/prefix must not be contained
-        return false;
-    } else if (word.empty()) {
-        // base case: we have walked all of the letters of this word/prefix
-        // and now we must do the removal
-        if (isPrefix) {
-            // remove this node and all of its descendents
-            removeSubtreeHelper(node, originalWord);   // removes from m_allWords, sets m_size
-            node = nullptr;
-        } else {
-            // found this word in the lexicon;
-            if (node->isLeaf()) {
-                // remove this leaf node only
-                delete node;
-                node = nullptr;
-            } else {
-                // de-word-ify this node, but leave it because it may
-                // still have children that are valid words
-                if (node->isWord()) {
-                    node->setWord(false);
-                }
-            }
-            m_allWords.remove(originalWord);
-            m_size--;
-        }
-        return true;
-    } else {
-        // recursive case: chop off first letter, traverse the rest
-        bool wasLeaf = node->isLeaf();
-        bool result = removeHelper(node->child(word[0]), word.substr(1), originalWord, isPrefix);
-
-        // memory cleanup: if I wasn't a leaf but now am, and am not a word,
-        // then I am now unneeded, so remove me too
-        if (result && !wasLeaf && node
-                && node->isLeaf() && !node->isWord()) {
-            delete node;
-            node = nullptr;
+// returns the index of the node that the letters of word from index from
+// on lead to from the given node, or -1 if there is none
+int Lexicon::findNode(uint32_t node, const std::string& word, size_t from) const {
+    for (size_t i = from; i < word.length(); i++) {
+        const TrieNode& current = m_nodes[node];
+        if (!current.hasChild(word[i])) {
+            return -1;
         }
-        return result;
+        node = current.child(word[i]);
     }
+    return node;
 }
 
-// remove/free this node and all descendents
-void Lexicon::removeSubtreeHelper(TrieNode*& node, const std::string& originalWord) {
-    if (node) {
-        for (char letter = 'a'; letter <= 'z'; letter++) {
-            removeSubtreeHelper(node->child(letter), originalWord + letter);
-        }
-        if (node->isWord()) {
-            m_allWords.remove(originalWord);
-            m_size--;
-        }
-        delete node;
-        node = nullptr;
+// pre: word is scrubbed to contain only lowercase a-z letters
+bool Lexicon::containsHelper(const std::string& word, bool isPrefix) const {
+    int node = findNode(word);
+    if (node == -1) {
+        // no path down to here, so prefix must not exist
+        return false;
     }
+    // Found nodes all the way down.
+    // If we are looking for a prefix, this means this path IS a prefix,
+    // so we should return true.
+    // If we are looking for an exact word match rather than a prefix,
+    // we must check the isWord flag to see that this word was added
+    return isPrefix ? true : m_nodes[node].isWord();
 }
 
-void Lexicon::deepCopy(const Lexicon& src) {
-    for (std::string word : src.m_allWords) {
-        add(word);
+// pre: word is scrubbed to contain only lowercase a-z letters
+bool Lexicon::removeHelper(const std::string& word, bool isPrefix) {
+    // walk down, remembering the path so that emptied nodes can be pruned on the way back
+    std::vector<uint32_t> path;
+    int found = findNode(word);
+    if (found == -1 || (!isPrefix && !m_nodes[found].isWord())) {
+        // dead end; this word/prefix must not be contained
+        return false;
+    }
+    uint32_t node = 0;
+    for (char letter : word) {
+        path.push_back(node);
+        node = m_nodes[node].child(letter);
     }
+
+    if (isPrefix) {
+        // remove this node and all of its descendents
+        removeSubtreeHelper(node);   // sets m_size
+        m_nodes[node].m_letters = 0;
+    } else {
+        // de-word-ify this node; it is only removed below if it has no children
+        m_nodes[node].setWord(false);
+        m_size--;
+    }
+
+    // memory cleanup: remove nodes that are now leaves and not words,
+    // from the bottom up
+    for (int i = (int) word.length() - 1; i >= 0; i--) {
+        uint32_t child = m_nodes[path[i]].child(word[i]);
+        if (!m_nodes[child].isLeaf() || m_nodes[child].isWord()) {
+            break;
+        }
+        removeChild(path[i], word[i]);
+    }
+    if (m_size == 0) {
+        clear();
+    } else if (m_unusedNodes > (int) m_nodes.size() / 2) {
+        compact();
+    }
+    return true;
 }
 
-void Lexicon::deleteTree(TrieNode* node) {
-    if (node) {
-        for (char letter = 'a'; letter <= 'z'; letter++) {
-            deleteTree(node->child(letter));
+// remove the words of this node and all descendents, counting their nodes as unused
+void Lexicon::removeSubtreeHelper(uint32_t node) {
+    for (char letter = 'a'; letter <= 'z'; letter++) {
+        if (m_nodes[node].hasChild(letter)) {
+            removeSubtreeHelper(m_nodes[node].child(letter));
+            m_unusedNodes++;
         }
-        delete node;
     }
+    if (m_nodes[node].isWord()) {
+        m_size--;
+    }
+}
+
+void Lexicon::deepCopy(const Lexicon& src) {
+    // the nodes only refer to each other by index, so the array copies as it is
+    m_nodes = src.m_nodes;
+    m_unusedNodes = src.m_unusedNodes;
+    m_size = src.m_size;
 }
 
 /*
@@ -592,9 +828,7 @@ bool Lexicon::isDAWGFile(const std::string& filename) const {
  */
 void Lexicon::readBinaryFile(std::istream& input) {
     DawgLexicon ldawg(input);
-    for (std::string word : ldawg) {
-        add(word);
-    }
+    addDawgWords(ldawg);
 }
 
 /*
@@ -603,9 +837,25 @@ void Lexicon::readBinaryFile(std::istream& input) {
  */
 void Lexicon::readBinaryFile(const std::string& filename) {
     DawgLexicon ldawg(filename);
+    addDawgWords(ldawg);
+}
+
+/*
+ * A DawgLexicon iterates in alphabetical order, so an empty lexicon can
+ * take its words with TrieBuilder.
+ */
+void Lexicon::addDawgWords(const DawgLexicon& ldawg) {
+    if (!isEmpty()) {
+        for (std::string word : ldawg) {
+            add(word);
+        }
+        return;
+    }
+    TrieBuilder builder(*this);
     for (std::string word : ldawg) {
-        add(word);
+        builder.add(word);
     }
+    builder.finish();
 }
 
 Lexicon& Lexicon::operator =(const Lexicon& src) {
@@ -617,8 +867,52 @@ Lexicon& Lexicon::operator =(const Lexicon& src) {
 }
 
 std::ostream& operator <<(std::ostream& out, const Lexicon& lex) {
-    out << lex.m_allWords;
-    return out;
+    // writeCollection would take a copy of the lexicon
+    return stanfordcpplib::collections::writeIterable(out, lex.begin(), lex.end());
+}
+
+/*
+ * Moves to the next word in alphabetical order: the first word below the
+ * current node if it has children, otherwise the first word below the next
+ * letter along from the current node or its nearest ancestor that has one.
+ */
+void Lexicon::iterator::advanceToNextWord() {
+    const std::vector<TrieNode>& nodes = lp->m_nodes;
+    if (path.empty()) {
+        return;   // already past the last word
+    }
+    if (nodes[path.back()].isLeaf()) {
+        // climb until a later letter has a child, and step across to it
+        while (true) {
+            char last = word.back();
+            word.pop_back();
+            path.pop_back();
+            if (path.empty()) {
+                return;
+            }
+            const TrieNode& parent = nodes[path.back()];
+            char letter = last + 1;
+            while (letter <= 'z' && !parent.hasChild(letter)) {
+                letter++;
+            }
+            if (letter <= 'z') {
+                word.push_back(letter);
+                path.push_back(parent.child(letter));
+                break;
+            }
+        }
+    } else {
+        const TrieNode& node = nodes[path.back()];
+        word.push_back(node.firstLetter());
+        path.push_back(node.m_firstChild);
+    }
+
+    // every leaf is a word, so following the lowest letters down reaches one
+    while (!nodes[path.back()].isWord()) {
+        const TrieNode& node = nodes[path.back()];
+        word.push_back(node.firstLetter());
+        path.push_back(node.m_firstChild);
+    }
 }
 
 std::istream& operator >>(std::istream& is, Lexicon& lex) {
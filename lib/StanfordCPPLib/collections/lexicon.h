@@ -5,6 +5,11 @@
  * compact structure for storing a list of words.
  *
  * @author Marty Stepp
+ * @version 2026/10/18
+ * - trie nodes stored in one array and linked by 32-bit index instead of pointer
+ * - iterates over the trie itself instead of a second Set of all words
+ * - builds the trie in one pass when a file's words are in alphabetical order
+ * - added methods containsBatch, neighborsAt
  * @version 2016/09/24
  * - refactored to use collections.h utility functions
  * @version 2016/08/12
@@ -23,12 +28,15 @@
 #ifndef _lexicon_h
 #define _lexicon_h
 
+#include <cstdint>
 #include <initializer_list>
 #include <iterator>
 #include <set>
 #include <string>
+#include <vector>
 #include "hashcode.h"
-#include "set.h"
+
+class DawgLexicon;
 
 /*
  * Class: Lexicon
@@ -125,6 +133,8 @@ public:
      * --------------------------------------
      * Reads the given input stream and adds all of its words to the lexicon.
      * Each word from the stream is converted to lowercase before adding it.
+     * If the lexicon is empty and the words are in alphabetical order, as in
+     * most word list files, the lexicon is built in a single pass.
      */
     void addWordsFromFile(std::istream& input);
     
@@ -169,6 +179,19 @@ public:
     bool containsAll(const Lexicon& set2) const;
     bool containsAll(std::initializer_list<std::string> list) const;
 
+    /*
+     * Method: containsBatch
+     * Usage: vector<bool> found = lex.containsBatch(words);
+     * -----------------------------------------------------
+     * Returns a vector whose element <i>k</i> is <code>true</code> if
+     * <code>words[k]</code> is contained in the lexicon, as for
+     * <code>contains</code>.  Each lookup starts where the word shares its
+     * first letters with the word before it, so the common prefix is only
+     * walked once; words in alphabetical order, or that only differ near
+     * their ends, are looked up fastest.
+     */
+    std::vector<bool> containsBatch(const std::vector<std::string>& words) const;
+
     /*
      * Method: containsPrefix
      * Usage: if (lex.containsPrefix(prefix)) ...
@@ -252,6 +275,21 @@ public:
     template <typename FunctorType>
     void mapAll(FunctorType fn) const;
 
+    /*
+     * Method: neighborsAt
+     * Usage: vector<string> neighbors = lex.neighborsAt(word, i);
+     * -----------------------------------------------------------
+     * Returns the words in the lexicon that differ from <code>word</code>
+     * only in the letter at index <code>i</code>, in lowercase and in
+     * alphabetical order; <code>word</code> itself is not included.  The
+     * letters before index <code>i</code> are walked once, and only the
+     * letters that can follow them there are tried with the rest of the
+     * word, instead of looking up each of the 25 other words in full.
+     * Returns an empty vector if <code>i</code> is not an index of
+     * <code>word</code>.
+     */
+    std::vector<std::string> neighborsAt(const std::string& word, int i) const;
+
     /*
      * Method: remove
      * Usage: lex.remove(word);
@@ -466,77 +504,116 @@ public:
     Lexicon& operator ,(const std::string& word);
 
 private:
+    /*
+     * The trie is kept in one array of nodes, m_nodes, and nodes refer to
+     * each other by index.  The children of a node sit next to each other
+     * in letter order, so a node only stores a bit for each letter that
+     * has a child and the index of its first child; the child for a letter
+     * is found by counting the bits below that letter's bit.  A node takes
+     * 8 bytes instead of the 200+ of a node with 26 child pointers, and a
+     * lookup reads one small node per letter from a single allocation.
+     *
+     * Adding a child moves the node's children to a new block at the end
+     * of the array, and removing words leaves unused nodes behind, so the
+     * array is compacted once more than half of it is unused.
+     */
     struct TrieNode {
     public:
         TrieNode() {
-            m_isWord = false;
-            for (int i = 0; i < 26; i++) {
-                m_children[i] = nullptr;
-            }
+            m_letters = 0;
+            m_firstChild = 0;
         }
 
         // pre: letter is between 'a' and 'z' in lowercase
-        inline TrieNode*& child(char letter) {
-            return m_children[letter - 'a'];
+        inline bool hasChild(char letter) const {
+            return (m_letters & (1u << (letter - 'a'))) != 0;
         }
 
-        inline int childCount() {
-            int count = 0;
-            for (int i = 0; i < 26; i++) {
-                if (m_children[i] != nullptr) {
-                    count++;
-                }
-            }
-            return count;
+        // pre: letter is between 'a' and 'z' in lowercase
+        // returns the index the child for the letter has, or would have, in m_nodes
+        inline uint32_t child(char letter) const {
+            return m_firstChild + countBits(m_letters & ((1u << (letter - 'a')) - 1));
         }
 
-        inline bool isLeaf() {
-            for (int i = 0; i < 26; i++) {
-                if (m_children[i] != nullptr) {
-                    return false;
-                }
+        // pre: the node has at least one child
+        inline char firstLetter() const {
+            char letter = 'a';
+            while (!hasChild(letter)) {
+                letter++;
             }
-            return true;
+            return letter;
+        }
+
+        inline int childCount() const {
+            return countBits(m_letters & ALL_LETTERS);
+        }
+
+        inline bool isLeaf() const {
+            return (m_letters & ALL_LETTERS) == 0;
         }
 
-        inline bool isWord() {
-            return m_isWord;
+        inline bool isWord() const {
+            return (m_letters & WORD_BIT) != 0;
         }
 
         inline void setWord(bool value) {
-            m_isWord = value;
+            m_letters = value ? (m_letters | WORD_BIT) : (m_letters & ~WORD_BIT);
         }
 
-    private:
         /* instance variables */
-        bool m_isWord;
-        TrieNode* m_children[26];   // 0=a, 1=b, 2=c, ..., 25=z
+        uint32_t m_letters;      // bit i set if there is a child for letter 'a' + i,
+                                 // WORD_BIT set if the path to this node spells a word
+        uint32_t m_firstChild;   // index in m_nodes of the child for the lowest letter
+
+        static const uint32_t ALL_LETTERS = (1u << 26) - 1;
+        static const uint32_t WORD_BIT = 1u << 26;
+
+    private:
+        static inline int countBits(uint32_t bits) {
+#if defined(__GNUC__)
+            return __builtin_popcount(bits);
+#else
+            bits = bits - ((bits >> 1) & 0x55555555u);
+            bits = (bits & 0x33333333u) + ((bits >> 2) & 0x33333333u);
+            return (((bits + (bits >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+#endif
+        }
     };
 
+    /*
+     * Builds the trie of an empty lexicon from words given in alphabetical
+     * order, in one pass and without moving any nodes; see lexicon.cpp.
+     */
+    class TrieBuilder;
+
     /*
      * private helper functions, including
-     * recursive helpers to implement public add/contains/remove
+     * helpers to implement public add/contains/remove
      */
-    bool addHelper(TrieNode*& node, const std::string& word, const std::string& originalWord);
-    bool containsHelper(TrieNode* node, const std::string& word, bool isPrefix) const;
+    bool addHelper(const std::string& word);
+    void addDawgWords(const DawgLexicon& ldawg);
+    uint32_t addChild(uint32_t node, char letter);
+    void compact();
+    bool containsHelper(const std::string& word, bool isPrefix) const;
     void deepCopy(const Lexicon& src);
-    void deleteTree(TrieNode* node);
+    int findNode(const std::string& word) const;
+    int findNode(uint32_t node, const std::string& word, size_t from) const;
     bool isDAWGFile(std::istream& input) const;
     bool isDAWGFile(const std::string& filename) const;
     void readBinaryFile(std::istream& input);
     void readBinaryFile(const std::string& filename);
-    bool removeHelper(TrieNode*& node, const std::string& word, const std::string& originalWord, bool isPrefix);
-    void removeSubtreeHelper(TrieNode*& node, const std::string& originalWord);
+    bool removeHelper(const std::string& word, bool isPrefix);
+    void removeChild(uint32_t node, char letter);
+    void removeSubtreeHelper(uint32_t node);
     
     friend std::ostream& operator <<(std::ostream& os, const Lexicon& lex);
     friend std::istream& operator >>(std::istream& is, Lexicon& lex);
 
     /* instance variables */
-    TrieNode* m_root;
+    std::vector<TrieNode> m_nodes; // m_nodes[0] is the root once a word has been added
+    int m_unusedNodes;             // nodes no longer reachable from the root
     int m_size;
     bool m_removeFlag;             // flag to differentiate += and -= when used with ,
-    Set<std::string> m_allWords;   // secondary structure of all words for foreach;
-                                   // basically a cop-out so I can loop over words
 
 public:
     /*
@@ -560,25 +637,70 @@ public:
      * iterators so that they work symmetrically with respect to the
      * corresponding STL classes.
      */
-    class iterator : public Set<std::string>::iterator {
+    class iterator : public std::iterator<std::input_iterator_tag, std::string> {
+    private:
+        const Lexicon* lp;
+        int index;                     // number of words before the current one
+        std::string word;              // the current word
+        std::vector<uint32_t> path;    // nodes from the root to the current word's node
+
+        void advanceToNextWord();
+
     public:
-        iterator() : Set<std::string>::iterator() {}
-        iterator(const iterator& it) : Set<std::string>::iterator(it) {}
-        iterator(const Set<std::string>::iterator& it) : Set<std::string>::iterator(it) {}
+        iterator() : lp(nullptr), index(0) {
+            /* empty */
+        }
+
+        iterator(const Lexicon* lp, bool endFlag) : lp(lp), index(0) {
+            if (endFlag) {
+                index = lp->size();
+            } else if (!lp->isEmpty()) {
+                path.push_back(0);   // the root, which is never a word itself
+                advanceToNextWord();
+            }
+        }
+
+        iterator& operator ++() {
+            advanceToNextWord();
+            index++;
+            return *this;
+        }
+
+        iterator operator ++(int) {
+            iterator copy(*this);
+            operator++();
+            return copy;
+        }
+
+        bool operator ==(const iterator& rhs) const {
+            return lp == rhs.lp && index == rhs.index;
+        }
+
+        bool operator !=(const iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+        const std::string& operator *() const {
+            return word;
+        }
+
+        const std::string* operator ->() const {
+            return &word;
+        }
     };
 
     /*
      * Returns an iterator positioned at the first word in the lexicon.
      */
     iterator begin() const {
-        return iterator(m_allWords.begin());
+        return iterator(this, /* endFlag */ false);
     }
 
     /*
      * Returns an iterator positioned at the last word in the lexicon.
      */
     iterator end() const {
-        return iterator(m_allWords.end());
+        return iterator(this, /* endFlag */ true);
     }
 };
 
@@ -4,6 +4,9 @@
  * This file exports the template class <code>Map</code>, which
  * maintains a collection of <i>key</i>-<i>value</i> pairs.
  * 
+ * @version 2026/10/18
+ * - tree nodes are allocated from a NodePool owned by the map instead of one
+ *   new/delete each; clear returns them all to the pool at once
  * @version 2016/12/09
  * - added iterator version checking support
  * @version 2016/09/24
@@ -36,6 +39,7 @@
 #include <cstdlib>
 #include <initializer_list>
 #include <map>
+#include <type_traits>
 #include <utility>
 #include "collections.h"
 #include "error.h"
@@ -464,6 +468,7 @@ private:
 
     // instance variables
     BSTNode* root;      // pointer to the root of the tree
+    stanfordcpplib::collections::NodePool<BSTNode> nodes;   // where the tree's nodes live
     int nodeCount;      // number of entries in the map
     Comparator* cmpp;   // pointer to the comparator
     unsigned int m_version;   // structure version for detecting invalid iterators
@@ -507,7 +512,7 @@ private:
     ValueType* addNode(BSTNode*& t, const KeyType& key, bool& heightFlag) {
         heightFlag = false;
         if (!t)  {
-            t = new BSTNode();
+            t = nodes.create();
             t->key = key;
             t->value = ValueType();
             t->bf = BST_IN_BALANCE;
@@ -583,12 +588,12 @@ private:
         BSTNode* toDelete = t;
         if (!t->left) {
             t = t->right;
-            delete toDelete;
+            nodes.destroy(toDelete);
             nodeCount--;
             return true;
         } else if (!t->right) {
             t = t->left;
-            delete toDelete;
+            nodes.destroy(toDelete);
             nodeCount--;
             return true;
         } else {
@@ -730,13 +735,14 @@ private:
     /*
      * Implementation notes: deleteTree(t)
      * -----------------------------------
-     * Deletes all the nodes in the tree.
+     * Destroys all the nodes in the tree.  Their memory stays in the pool
+     * until clear resets it.
      */
     void deleteTree(BSTNode* t) {
         if (t) {
             deleteTree(t->left);
             deleteTree(t->right);
-            delete t;
+            nodes.destroy(t);
         }
     }
 
@@ -782,7 +788,7 @@ private:
         if (!t) {
             return nullptr;
         } else {
-            BSTNode* np = new BSTNode;
+            BSTNode* np = nodes.create();
             np->key = t->key;
             np->value = t->value;
             np->bf = t->bf;
@@ -1023,7 +1029,12 @@ Map<KeyType, ValueType>& Map<KeyType, ValueType>::addAll(
 
 template <typename KeyType, typename ValueType>
 void Map<KeyType, ValueType>::clear() {
-    deleteTree(root);
+    // nodes with nothing to destroy, such as those of a Map<int, int>, are
+    // dropped all at once by resetting the pool without walking the tree
+    if (!std::is_trivially_destructible<BSTNode>::value) {
+        deleteTree(root);
+    }
+    nodes.reset();
     root = nullptr;
     nodeCount = 0;
     m_version++;
@@ -5,6 +5,14 @@
  * in which values are ordinarily processed in a first-in/first-out
  * (FIFO) order.
  * 
+ * @version 2026/10/18
+ * - ring buffer kept in an array owned by the queue; growing it moves the elements
+ *   into the new array instead of copying them twice through a Vector
+ * - added ensureCapacity and its synonym reserve
+ * - clear keeps the ring buffer so a reused queue does not allocate again
+ * - added move constructor and move assignment
+ * - added enqueue and add overloads that move the value in, and emplace
+ * - dequeue moves the front element out instead of copying it
  * @version 2016/09/24
  * - refactored to use collections.h utility functions
  * - added iterators begin(), end()
@@ -34,6 +42,7 @@
 #include <initializer_list>
 #include <iterator>
 #include <queue>
+#include <utility>
 #include "collections.h"
 #include "error.h"
 #include "hashcode.h"
@@ -81,6 +90,7 @@ public:
      * A synonym for the enqueue method.
      */
     void add(const ValueType& value);
+    void add(ValueType&& value);
 
     /*
      * Method: back
@@ -94,7 +104,8 @@ public:
      * Method: clear
      * Usage: queue.clear();
      * ---------------------
-     * Removes all elements from the queue.
+     * Removes all elements from the queue.  The queue keeps the room
+     * it has made for elements, so filling it again does not allocate.
      */
     void clear();
     
@@ -102,17 +113,32 @@ public:
      * Method: dequeue
      * Usage: ValueType first = queue.dequeue();
      * -----------------------------------------
-     * Removes and returns the first item in the queue.
+     * Removes and returns the first item in the queue.  The item is moved
+     * out of the queue, so dequeuing strings or collections does not
+     * copy them.
      */
     ValueType dequeue();
 
+    /*
+     * Method: emplace
+     * Usage: queue.emplace(args);
+     * ---------------------------
+     * Adds a new value made from the given constructor arguments to the end
+     * of the queue, moving it into place rather than copying it.
+     */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
     /*
      * Method: enqueue
      * Usage: queue.enqueue(value);
      * ----------------------------
-     * Adds <code>value</code> to the end of the queue.
+     * Adds <code>value</code> to the end of the queue.  If the value is a
+     * temporary or passed with std::move, it is moved into the queue
+     * instead of being copied.
      */
     void enqueue(const ValueType& value);
+    void enqueue(ValueType&& value);
     
     /*
      * Method: equals
@@ -133,6 +159,17 @@ public:
      */
     const ValueType& front() const;
 
+    /*
+     * Method: ensureCapacity
+     * Usage: queue.ensureCapacity(n);
+     * -------------------------------
+     * Makes room for at least <code>n</code> elements, so that the queue
+     * does not have to grow again until it holds more than that.  Growing
+     * a queue moves its elements into a larger array, so a queue that is
+     * known to get long can save those moves by making room up front.
+     */
+    void ensureCapacity(int n);
+
     /*
      * Method: isEmpty
      * Usage: if (queue.isEmpty()) ...
@@ -161,6 +198,15 @@ public:
      */
     ValueType remove();
 
+    /*
+     * Method: reserve
+     * Usage: queue.reserve(n);
+     * ------------------------
+     * Makes room for at least <code>n</code> elements.
+     * A synonym for the ensureCapacity method.
+     */
+    void reserve(int n);
+
     /*
      * Method: size
      * Usage: int n = queue.size();
@@ -239,7 +285,7 @@ public:
 
 private:
     /* Instance variables */
-    Vector<ValueType> ringBuffer;
+    ValueType* ringBuffer;   /* Array of capacity elements, or nullptr if capacity is 0 */
     int count;
     int capacity;
     int head;
@@ -247,8 +293,32 @@ private:
 
     /* Private functions */
     void expandRingBufferCapacity();
+    void moveRingBuffer(int newCapacity);
+    void deepCopy(const Queue& src);
     int queueCompare(const Queue& queue2) const;
 
+public:
+    /*
+     * Deep copying support
+     * --------------------
+     * This copy constructor and operator= are defined to make a deep
+     * copy, making it possible to pass or return queues by value and
+     * assign from one queue to another.
+     */
+    Queue(const Queue& src);
+    Queue& operator =(const Queue& src);
+
+    /*
+     * Move support
+     * ------------
+     * The move constructor and move operator= take over the ring buffer of
+     * the queue moved from, which is left empty.
+     */
+    Queue(Queue&& src);
+    Queue& operator =(Queue&& src);
+
+private:
+
     /*
      * Iterator support
      * ----------------
@@ -336,27 +406,44 @@ static const int INITIAL_CAPACITY = 10;
  * elements and initialize the fields of the object.
  */
 template <typename ValueType>
-Queue<ValueType>::Queue() {
-    clear();
+Queue<ValueType>::Queue()
+        : ringBuffer(nullptr), count(0), capacity(0), head(0), tail(0) {
+    // empty
 }
 
 template <typename ValueType>
-Queue<ValueType>::Queue(std::initializer_list<ValueType> list) {
-    clear();
+Queue<ValueType>::Queue(std::initializer_list<ValueType> list)
+        : ringBuffer(nullptr), count(0), capacity(0), head(0), tail(0) {
+    ensureCapacity(list.size());
     for (const ValueType& value : list) {
         add(value);
     }
 }
 
+template <typename ValueType>
+Queue<ValueType>::Queue(const Queue& src) {
+    deepCopy(src);
+}
+
+template <typename ValueType>
+Queue<ValueType>::Queue(Queue&& src)
+        : ringBuffer(src.ringBuffer), count(src.count), capacity(src.capacity),
+          head(src.head), tail(src.tail) {
+    src.ringBuffer = nullptr;
+    src.count = 0;
+    src.capacity = 0;
+    src.head = 0;
+    src.tail = 0;
+}
+
 /*
  * Implementation notes: ~Queue destructor
  * ---------------------------------------
- * All of the dynamic memory is allocated in the Vector class,
- * so no work is required at this level.
+ * The destructor frees the ring buffer array.
  */
 template <typename ValueType>
 Queue<ValueType>::~Queue() {
-    // empty
+    delete[] ringBuffer;
 }
 
 template <typename ValueType>
@@ -364,6 +451,11 @@ void Queue<ValueType>::add(const ValueType& value) {
     enqueue(value);
 }
 
+template <typename ValueType>
+void Queue<ValueType>::add(ValueType&& value) {
+    enqueue(std::move(value));
+}
+
 template <typename ValueType>
 const ValueType& Queue<ValueType>::back() const {
     if (count == 0) {
@@ -374,8 +466,10 @@ const ValueType& Queue<ValueType>::back() const {
 
 template <typename ValueType>
 void Queue<ValueType>::clear() {
-    capacity = INITIAL_CAPACITY;
-    ringBuffer = Vector<ValueType>(capacity);
+    // reset the elements still queued so the memory they hold is freed
+    for (int i = 0; i < count; i++) {
+        ringBuffer[(head + i) % capacity] = ValueType();
+    }
     head = 0;
     tail = 0;
     count = 0;
@@ -392,22 +486,48 @@ ValueType Queue<ValueType>::dequeue() {
     if (count == 0) {
         error("Queue::dequeue: Attempting to dequeue an empty queue");
     }
-    ValueType result = ringBuffer[head];
+    ValueType result = std::move(ringBuffer[head]);
     head = (head + 1) % capacity;
     count--;
     return result;
 }
 
+template <typename ValueType>
+template <typename... Args>
+void Queue<ValueType>::emplace(Args&&... args) {
+    enqueue(ValueType(std::forward<Args>(args)...));
+}
+
+/*
+ * Implementation notes: enqueue
+ * -----------------------------
+ * Enqueuing a copy first copies the value and then moves the copy in,
+ * which keeps it safe to enqueue one of this queue's own elements when
+ * the ring buffer is about to be moved.
+ */
 template <typename ValueType>
 void Queue<ValueType>::enqueue(const ValueType& value) {
+    enqueue(ValueType(value));
+}
+
+template <typename ValueType>
+void Queue<ValueType>::enqueue(ValueType&& value) {
     if (count >= capacity - 1) {
         expandRingBufferCapacity();
     }
-    ringBuffer[tail] = value;
+    ringBuffer[tail] = std::move(value);
     tail = (tail + 1) % capacity;
     count++;
 }
 
+template <typename ValueType>
+void Queue<ValueType>::ensureCapacity(int n) {
+    // one slot is always left empty, so that a full ring buffer has head != tail
+    if (n > 0 && n >= capacity) {
+        moveRingBuffer(n + 1);
+    }
+}
+
 template <typename ValueType>
 bool Queue<ValueType>::equals(const Queue<ValueType>& queue2) const {
     return stanfordcpplib::collections::equals(*this, queue2);
@@ -431,7 +551,7 @@ const ValueType& Queue<ValueType>::peek() const {
     if (count == 0) {
         error("Queue::peek: Attempting to peek at an empty queue");
     }
-    return ringBuffer.get(head);
+    return ringBuffer[head];
 }
 
 template <typename ValueType>
@@ -444,6 +564,11 @@ ValueType Queue<ValueType>::remove() {
     return dequeue();
 }
 
+template <typename ValueType>
+void Queue<ValueType>::reserve(int n) {
+    ensureCapacity(n);
+}
+
 template <typename ValueType>
 int Queue<ValueType>::size() const {
     return count;
@@ -477,20 +602,79 @@ std::string Queue<ValueType>::toString() const {
 /*
  * Implementation notes: expandRingBufferCapacity
  * ----------------------------------------------
- * This private method doubles the capacity of the ringBuffer vector.
- * Note that this implementation also shifts all the elements back to
- * the beginning of the vector.
+ * This private method doubles the capacity of the ringBuffer array,
+ * or allocates the first one.
  */
 template <typename ValueType>
 void Queue<ValueType>::expandRingBufferCapacity() {
-    Vector<ValueType> copy = ringBuffer;
-    ringBuffer = Vector<ValueType>(2 * capacity);
+    moveRingBuffer(capacity == 0 ? INITIAL_CAPACITY : 2 * capacity);
+}
+
+/*
+ * Implementation notes: moveRingBuffer
+ * ------------------------------------
+ * This private method replaces the ringBuffer array with one of the
+ * given capacity, which must be larger than the number of elements.
+ * The elements are moved rather than copied into the new array, so a
+ * queue of strings or collections only moves their handles, and they
+ * are shifted back to the beginning of the array.
+ */
+template <typename ValueType>
+void Queue<ValueType>::moveRingBuffer(int newCapacity) {
+    ValueType* array = new ValueType[newCapacity];
+    for (int i = 0; i < count; i++) {
+        array[i] = std::move(ringBuffer[(head + i) % capacity]);
+    }
+    delete[] ringBuffer;
+    ringBuffer = array;
+    capacity = newCapacity;
+    head = 0;
+    tail = count;
+}
+
+/*
+ * Implementation notes: deepCopy
+ * ------------------------------
+ * Copies the elements of src in order into a new array just large
+ * enough to hold them.
+ */
+template <typename ValueType>
+void Queue<ValueType>::deepCopy(const Queue& src) {
+    count = src.count;
+    capacity = (src.count == 0) ? 0 : src.count + 1;
+    ringBuffer = (capacity == 0) ? nullptr : new ValueType[capacity];
     for (int i = 0; i < count; i++) {
-        ringBuffer[i] = copy[(head + i) % capacity];
+        ringBuffer[i] = src.ringBuffer[(src.head + i) % src.capacity];
     }
     head = 0;
     tail = count;
-    capacity *= 2;
+}
+
+template <typename ValueType>
+Queue<ValueType>& Queue<ValueType>::operator =(const Queue& src) {
+    if (this != &src) {
+        delete[] ringBuffer;
+        deepCopy(src);
+    }
+    return *this;
+}
+
+template <typename ValueType>
+Queue<ValueType>& Queue<ValueType>::operator =(Queue&& src) {
+    if (this != &src) {
+        delete[] ringBuffer;
+        ringBuffer = src.ringBuffer;
+        count = src.count;
+        capacity = src.capacity;
+        head = src.head;
+        tail = src.tail;
+        src.ringBuffer = nullptr;
+        src.count = 0;
+        src.capacity = 0;
+        src.head = 0;
+        src.tail = 0;
+    }
+    return *this;
 }
 
 template <typename ValueType>
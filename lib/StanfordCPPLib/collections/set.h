@@ -4,6 +4,9 @@
  * This file exports the <code>Set</code> class, which implements a
  * collection for storing a set of distinct elements.
  * 
+ * @version 2026/10/18
+ * - backed by a Map whose nodes come from its own NodePool, so adding an element
+ *   usually does not allocate
  * @version 2016/12/06
  * - slight speedup bug fix in equals() method
  * @version 2016/09/24
@@ -4,6 +4,10 @@
  * This file exports the <code>Stack</code> class, which implements
  * a collection that processes values in a last-in/first-out (LIFO) order.
  * 
+ * @version 2026/10/18
+ * - added move constructor and move assignment
+ * - added push and add overloads that move the value in, and emplace
+ * - pop moves the top element out instead of copying it
  * @version 2016/09/24
  * - refactored to use collections.h utility functions
  * - made const iterators public
@@ -24,6 +28,7 @@
 #include <initializer_list>
 #include <iterator>
 #include <stack>
+#include <utility>
 #include "error.h"
 #include "hashcode.h"
 #include "vector.h"
@@ -72,6 +77,7 @@ public:
      * A synonym for the push method.
      */
     void add(const ValueType& value);
+    void add(ValueType&& value);
     
     /*
      * Method: clear
@@ -80,6 +86,16 @@ public:
      * Removes all elements from this stack.
      */
     void clear();
+
+    /*
+     * Method: emplace
+     * Usage: stack.emplace(args);
+     * ---------------------------
+     * Pushes a new value made from the given constructor arguments onto the
+     * top of this stack, moving it into place rather than copying it.
+     */
+    template <typename... Args>
+    void emplace(Args&&... args);
     
     /*
      * Method: equals
@@ -113,7 +129,9 @@ public:
      * Usage: ValueType top = stack.pop();
      * -----------------------------------
      * Removes the top element from this stack and returns it.  This
-     * method signals an error if called on an empty stack.
+     * method signals an error if called on an empty stack.  The element
+     * is moved out of the stack, so popping a stack of strings or
+     * collections does not copy them.
      */
     ValueType pop();
     
@@ -121,9 +139,12 @@ public:
      * Method: push
      * Usage: stack.push(value);
      * -------------------------
-     * Pushes the specified value onto the top of this stack.
+     * Pushes the specified value onto the top of this stack.  If the value
+     * is a temporary or passed with std::move, it is moved onto the stack
+     * instead of being copied.
      */
     void push(const ValueType& value);
+    void push(ValueType&& value);
 
     /*
      * Method: remove
@@ -220,6 +241,17 @@ public:
     template <typename T>
     friend std::ostream& operator <<(std::ostream& os, const Stack<T>& stack);
     
+    /*
+     * Copying and moving support
+     * --------------------------
+     * A stack is copied or moved by copying or moving its vector of
+     * elements.  A stack that is moved from is left empty.
+     */
+    Stack(const Stack& src) = default;
+    Stack(Stack&& src) = default;
+    Stack& operator =(const Stack& src) = default;
+    Stack& operator =(Stack&& src) = default;
+
 private:
     Vector<ValueType> elements;
 
@@ -307,11 +339,22 @@ void Stack<ValueType>::add(const ValueType& value) {
     push(value);
 }
 
+template <typename ValueType>
+void Stack<ValueType>::add(ValueType&& value) {
+    push(std::move(value));
+}
+
 template <typename ValueType>
 void Stack<ValueType>::clear() {
     elements.clear();
 }
 
+template <typename ValueType>
+template <typename... Args>
+void Stack<ValueType>::emplace(Args&&... args) {
+    elements.emplace_back(std::forward<Args>(args)...);
+}
+
 template <typename ValueType>
 bool Stack<ValueType>::equals(const Stack<ValueType>& stack2) const {
     return stanfordcpplib::collections::equals(*this, stack2);
@@ -335,7 +378,7 @@ ValueType Stack<ValueType>::pop() {
     if (isEmpty()) {
         error("Stack::pop: Attempting to pop an empty stack");
     }
-    ValueType top = elements[elements.size() - 1];
+    ValueType top = std::move(elements[elements.size() - 1]);
     elements.remove(elements.size() - 1);
     return top;
 }
@@ -345,6 +388,11 @@ void Stack<ValueType>::push(const ValueType& value) {
     elements.add(value);
 }
 
+template <typename ValueType>
+void Stack<ValueType>::push(ValueType&& value) {
+    elements.add(std::move(value));
+}
+
 template <typename ValueType>
 ValueType Stack<ValueType>::remove() {
     return pop();
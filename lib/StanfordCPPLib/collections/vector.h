@@ -4,6 +4,11 @@
  * This file exports the <code>Vector</code> class, which provides an
  * efficient, safe, convenient replacement for the array type in C++.
  *
+ * @version 2026/10/18
+ * - added move constructor and move assignment, which take over the other
+ *   vector's array instead of copying it
+ * - added add, insert, push_back overloads that move the value in, and emplace_back
+ * - elements are moved rather than copied when the array grows or is shifted
  * @version 2016/12/09
  * - added iterator version checking support
  * @version 2016/09/24
@@ -41,6 +46,7 @@
 #include <iterator>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 #include "collections.h"
 #include "error.h"
@@ -96,9 +102,12 @@ public:
      * Method: add
      * Usage: vec.add(value);
      * ----------------------
-     * Adds a new value to the end of this vector.
+     * Adds a new value to the end of this vector.  If the value is a
+     * temporary or passed with std::move, it is moved into the vector
+     * instead of being copied.
      */
     void add(const ValueType& value);
+    void add(ValueType&& value);
 
     /*
      * Method: addAll
@@ -139,6 +148,16 @@ public:
      * Identical in behavior to the == operator.
      */
     bool equals(const Vector<ValueType>& v) const;
+
+    /*
+     * Method: emplace_back
+     * Usage: vec.emplace_back(args);
+     * ------------------------------
+     * Adds a new value made from the given constructor arguments to the end
+     * of this vector, moving it into place rather than copying it.
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args);
     
     /*
      * Method: get
@@ -159,6 +178,7 @@ public:
      * up to and including the length of the vector.
      */
     void insert(int index, const ValueType& value);
+    void insert(int index, ValueType&& value);
 
     /*
      * Method: isEmpty
@@ -190,6 +210,7 @@ public:
      * with the <code>vector</code> class in the Standard Template Library.
      */
     void push_back(const ValueType& value);
+    void push_back(ValueType&& value);
 
     /*
      * Method: remove
@@ -387,6 +408,16 @@ public:
     Vector(const Vector& src);
     Vector& operator =(const Vector& src);
 
+    /*
+     * Move support
+     * ------------
+     * This move constructor and move operator= take over the array of a
+     * vector that is about to be discarded, such as one returned by value,
+     * instead of copying its elements.  The vector moved from is left empty.
+     */
+    Vector(Vector&& src);
+    Vector& operator =(Vector&& src);
+
     /*
      * Operator: ,
      * -----------
@@ -629,6 +660,18 @@ Vector<ValueType>::Vector(const Vector& src) {
     deepCopy(src);
 }
 
+template <typename ValueType>
+Vector<ValueType>::Vector(Vector&& src)
+        : elements(src.elements),
+          capacity(src.capacity),
+          count(src.count),
+          m_version(0) {
+    src.elements = nullptr;
+    src.capacity = 0;
+    src.count = 0;
+    src.m_version++;
+}
+
 template <typename ValueType>
 Vector<ValueType>::~Vector() {
     if (elements) {
@@ -648,6 +691,11 @@ void Vector<ValueType>::add(const ValueType& value) {
     insert(count, value);
 }
 
+template <typename ValueType>
+void Vector<ValueType>::add(ValueType&& value) {
+    insert(count, std::move(value));
+}
+
 template <typename ValueType>
 Vector<ValueType>& Vector<ValueType>::addAll(const Vector<ValueType>& v) {
     for (const ValueType& value : v) {
@@ -685,7 +733,7 @@ void Vector<ValueType>::ensureCapacity(int cap) {
         ValueType* array = new ValueType[capacity];
         if (elements) {
             for (int i = 0; i < count; i++) {
-                array[i] = elements[i];
+                array[i] = std::move(elements[i]);
             }
             delete[] elements;
         }
@@ -701,7 +749,7 @@ bool Vector<ValueType>::equals(const Vector<ValueType>& v) const {
 /*
  * Implementation notes: expandCapacity
  * ------------------------------------
- * This function doubles the array capacity, copies the old elements
+ * This function doubles the array capacity, moves the old elements
  * into the new array, and then frees the old one.
  * See also: ensureCapacity
  */
@@ -711,13 +759,19 @@ void Vector<ValueType>::expandCapacity() {
     ValueType *array = new ValueType[capacity];
     if (elements) {
         for (int i = 0; i < count; i++) {
-            array[i] = elements[i];
+            array[i] = std::move(elements[i]);
         }
         delete[] elements;
     }
     elements = array;
 }
 
+template <typename ValueType>
+template <typename... Args>
+void Vector<ValueType>::emplace_back(Args&&... args) {
+    add(ValueType(std::forward<Args>(args)...));
+}
+
 template <typename ValueType>
 const ValueType& Vector<ValueType>::get(int index) const {
     checkIndex(index, 0, count-1, "get");
@@ -729,18 +783,26 @@ const ValueType& Vector<ValueType>::get(int index) const {
  * -----------------------------------------
  * These methods must shift the existing elements in the array to
  * make room for a new element or to close up the space left by a
- * deleted one.
+ * deleted one.  Elements are moved, not copied, along the array.
+ * Inserting a copy first copies the value and then moves the copy in,
+ * which also keeps it safe to insert one of this vector's own elements
+ * when the array is about to be reallocated.
  */
 template <typename ValueType>
 void Vector<ValueType>::insert(int index, const ValueType& value) {
+    insert(index, ValueType(value));
+}
+
+template <typename ValueType>
+void Vector<ValueType>::insert(int index, ValueType&& value) {
     checkIndex(index, 0, count, "insert");
     if (count == capacity) {
         expandCapacity();
     }
     for (int i = count; i > index; i--) {
-        elements[i] = elements[i - 1];
+        elements[i] = std::move(elements[i - 1]);
     }
-    elements[index] = value;
+    elements[index] = std::move(value);
     count++;
     m_version++;
 }
@@ -783,11 +845,16 @@ void Vector<ValueType>::push_back(const ValueType& value) {
     insert(count, value);
 }
 
+template <typename ValueType>
+void Vector<ValueType>::push_back(ValueType&& value) {
+    insert(count, std::move(value));
+}
+
 template <typename ValueType>
 void Vector<ValueType>::remove(int index) {
     checkIndex(index, 0, count-1, "remove");
     for (int i = index; i < count - 1; i++) {
-        elements[i] = elements[i + 1];
+        elements[i] = std::move(elements[i + 1]);
     }
     count--;
     m_version++;
@@ -925,6 +992,24 @@ Vector<ValueType> & Vector<ValueType>::operator =(const Vector& src) {
     return *this;
 }
 
+template <typename ValueType>
+Vector<ValueType> & Vector<ValueType>::operator =(Vector&& src) {
+    if (this != &src) {
+        if (elements) {
+            delete[] elements;
+        }
+        elements = src.elements;
+        capacity = src.capacity;
+        count = src.count;
+        m_version++;
+        src.elements = nullptr;
+        src.capacity = 0;
+        src.count = 0;
+        src.m_version++;
+    }
+    return *this;
+}
+
 template <typename ValueType>
 void Vector<ValueType>::checkIndex(int index, int min, int max, std::string prefix) const {
     if (index < min || index > max) {
@@ -0,0 +1,39 @@
+/*
+* This is the implementation of the ComponentLabels class.
+*/
+
+#include "componentlabels.h"
+using namespace std;
+
+int ComponentLabels::componentOf(int id) const {
+    return labels[id];
+}
+
+bool ComponentLabels::areConnected(int idOne, int idTwo) const {
+    return labels[idOne] == labels[idTwo];
+}
+
+int ComponentLabels::componentCount() const {
+    return sizes.size();
+}
+
+int ComponentLabels::componentSize(int component) const {
+    return sizes[component];
+}
+
+/*
+ * Function: findRoot
+ * Usage:
+ * Finds the root of a word's union-find tree, pointing each word on the way at its grandparent
+ * so later searches take fewer steps
+ * Params: id (int)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the ID of the root word
+*/
+int ComponentLabels::findRoot(int id) {
+    while (labels[id] != id) {
+        labels[id] = labels[labels[id]];
+        id = labels[id];
+    }
+    return id;
+}
@@ -0,0 +1,111 @@
+/*
+* This file declares the ComponentLabels class, which splits the words of a neighbour index into
+* connected components: two words are in the same component exactly when there is a word ladder
+* between them. Labelling the components once means a pair of words with no ladder between them
+* can be turned away straight away, instead of after searching every word reachable from word 1.
+* The component sizes also show how much of each word length a single search can reach.
+*/
+
+#ifndef _componentlabels_h
+#define _componentlabels_h
+
+#include <utility>
+#include <vector>
+
+class ComponentLabels {
+public:
+    /*
+     * Constructor: ComponentLabels
+     * Usage: ComponentLabels components(index);
+     * Labels the components of a neighbour index (a WordGraph or WildcardIndex) with a union-find
+     * pass over the neighbours of every word. Components are numbered in order of their first
+     * word's ID, so the components of each word length have consecutive numbers
+     * Params: index (WordGraph or WildcardIndex)
+     * ---------------------------------------------------------------------------------------------
+     */
+    template <typename NeighbourIndex>
+    ComponentLabels(const NeighbourIndex &index);
+
+    /*
+     * Method: componentOf
+     * Usage: int component = components.componentOf(id);
+     * Params: id (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the number of the component the word with the given ID belongs to
+     */
+    int componentOf(int id) const;
+
+    /*
+     * Method: areConnected
+     * Usage: if (components.areConnected(idOne, idTwo)) ...
+     * Params: idOne (int), idTwo (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: true if there is a word ladder between the two words
+     */
+    bool areConnected(int idOne, int idTwo) const;
+
+    /*
+     * Method: componentCount
+     * Usage: int n = components.componentCount();
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the number of components, counting each word with no neighbours as one
+     */
+    int componentCount() const;
+
+    /*
+     * Method: componentSize
+     * Usage: int n = components.componentSize(component);
+     * Params: component (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the number of words in the given component
+     */
+    int componentSize(int component) const;
+
+private:
+    int findRoot(int id);
+
+    /* instance variables */
+    std::vector<int> labels;  // component of each word, by ID; holds union-find parents while
+                              // the components are being found
+    std::vector<int> sizes;   // number of words in each component
+};
+
+template <typename NeighbourIndex>
+ComponentLabels::ComponentLabels(const NeighbourIndex &index) {
+    // Union-find: every word starts as its own root, and neighbours have their roots joined,
+    // the smaller tree under the larger
+    labels.resize(index.size());
+    std::vector<int> treeSizes(index.size(), 1);
+    for (int id = 0; id < index.size(); id++) {
+        labels[id] = id;
+    }
+    for (int id = 0; id < index.size(); id++) {
+        index.mapNeighbours(id, [&](int neighbourWord) {
+            int root = findRoot(id);
+            int otherRoot = findRoot(neighbourWord);
+            if (root != otherRoot) {
+                if (treeSizes[root] < treeSizes[otherRoot]) {
+                    std::swap(root, otherRoot);
+                }
+                labels[otherRoot] = root;
+                treeSizes[root] += treeSizes[otherRoot];
+            }
+        });
+    }
+
+    // Number the roots in ID order, then label every word with its root's number
+    std::vector<int> roots(index.size());
+    std::vector<int> componentOfRoot(index.size(), -1);
+    for (int id = 0; id < index.size(); id++) {
+        roots[id] = findRoot(id);
+        if (componentOfRoot[roots[id]] == -1) {
+            componentOfRoot[roots[id]] = sizes.size();
+            sizes.push_back(treeSizes[roots[id]]);
+        }
+    }
+    for (int id = 0; id < index.size(); id++) {
+        labels[id] = componentOfRoot[roots[id]];
+    }
+}
+
+#endif // _componentlabels_h
@@ -0,0 +1,327 @@
+/*
+* This is the implementation of the graph file. On Mac and Linux the file is mapped read-only with
+* mmap, so its pages are shared between processes and nothing is parsed or copied. Opening a file
+* still reads all of it once: the checksum covers the whole payload, and the offset arrays and
+* every neighbour ID are checked so that searches can index by them without checks of their own.
+* On Windows the file is read into a buffer instead.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "graphfile.h"
+#include "error.h"
+#include "strlib.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// Layout of the file header; see graphfile.h
+struct GraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t wordCount;
+    uint32_t maxLength;
+    uint32_t neighbourCount;
+    uint32_t reserved;
+    uint64_t payloadSize;
+    uint64_t checksum;
+};
+
+static const char GRAPH_FILE_MAGIC[8] = {'W', 'L', 'G', 'R', 'A', 'P', 'H', '\0'};
+static const uint32_t GRAPH_FILE_VERSION = 1;
+static const uint32_t GRAPH_FILE_BYTE_ORDER = 0x01020304;
+
+static uint64_t checksum(const char *bytes, size_t size);
+
+MappedWordGraph::MappedWordGraph(const string &filename) : data(nullptr), dataSize(0) {
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd == -1 || fstat(fd, &status) == -1) {
+        if (fd != -1) {
+            close(fd);
+        }
+        error("MappedWordGraph: Can't open graph file " + filename);
+    }
+    dataSize = status.st_size;
+    void *mapping = dataSize == 0
+            ? MAP_FAILED : mmap(nullptr, dataSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        error("MappedWordGraph: Can't map graph file " + filename);
+    }
+    data = (const char *) mapping;
+#else
+    ifstream input(filename.c_str(), ios::binary);
+    if (input.fail()) {
+        error("MappedWordGraph: Can't open graph file " + filename);
+    }
+    buffer.assign(istreambuf_iterator<char>(input), istreambuf_iterator<char>());
+    data = buffer.data();
+    dataSize = buffer.size();
+#endif
+
+    // Check the header before trusting any of the sizes in it
+    const GraphFileHeader *header = (const GraphFileHeader *) data;
+    string problem;
+    if (dataSize < sizeof(GraphFileHeader) || memcmp(header->magic, GRAPH_FILE_MAGIC, 8) != 0) {
+        problem = "is not a graph file";
+    } else if (header->byteOrder != GRAPH_FILE_BYTE_ORDER) {
+        problem = "was written on a machine with a different byte order";
+    } else if (header->version != GRAPH_FILE_VERSION) {
+        problem = "has version " + integerToString(header->version) + ", expected "
+                + integerToString(GRAPH_FILE_VERSION);
+    } else if (header->payloadSize != dataSize - sizeof(GraphFileHeader)) {
+        problem = "is truncated";
+    } else if (checksum(data + sizeof(GraphFileHeader), header->payloadSize)
+               != header->checksum) {
+        problem = "is corrupt";
+    }
+    if (problem == "") {
+        uint64_t numberCount = (uint64_t) header->maxLength + 2 + header->wordCount + 1
+                + header->neighbourCount;
+        if (header->wordCount > INT32_MAX || header->maxLength > INT32_MAX - 2
+                || numberCount * sizeof(uint32_t) > header->payloadSize) {
+            problem = "is inconsistent";
+        }
+    }
+    if (problem == "") {
+        wordCount = header->wordCount;
+        maxLength = header->maxLength;
+        lengthStart = (const uint32_t *) (data + sizeof(GraphFileHeader));
+        neighbourStart = lengthStart + maxLength + 2;
+        neighbours = neighbourStart + wordCount + 1;
+        letters = (const char *) (neighbours + header->neighbourCount);
+        if (!checkArrays(header->neighbourCount)) {
+            problem = "is inconsistent";
+        }
+    }
+    if (problem == "") {
+        letterStart.assign(maxLength + 2, 0);
+        for (int length = 1; length <= maxLength + 1; length++) {
+            letterStart[length] = letterStart[length - 1]
+                    + (size_t) (lengthStart[length] - lengthStart[length - 1]) * (length - 1);
+        }
+        if (letters + letterStart[maxLength + 1] != data + dataSize) {
+            problem = "is inconsistent";
+        }
+    }
+    if (problem != "") {
+        unmap();
+        error("MappedWordGraph: " + filename + " " + problem);
+    }
+}
+
+MappedWordGraph::~MappedWordGraph() {
+    unmap();
+}
+
+bool MappedWordGraph::contains(const string &word) const {
+    return indexOf(word) != -1;
+}
+
+int MappedWordGraph::indexOf(const string &word) const {
+    int length = word.length();
+    if (length <= 0 || length > maxLength) {
+        return -1;
+    }
+    // Words of the same length are stored alphabetically, so binary search their ID range
+    int low = lengthStart[length];
+    int high = lengthStart[length + 1] - 1;
+    while (low <= high) {
+        int middle = low + (high - low) / 2;
+        int comparison = memcmp(lettersOf(middle, length), word.data(), length);
+        if (comparison == 0) {
+            return middle;
+        } else if (comparison < 0) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return -1;
+}
+
+string MappedWordGraph::wordAt(int id) const {
+    int length = lengthOf(id);
+    return string(lettersOf(id, length), length);
+}
+
+int MappedWordGraph::size() const {
+    return wordCount;
+}
+
+int MappedWordGraph::firstIdOfLength(int length) const {
+    if (length <= 0 || length > maxLength) {
+        return wordCount;
+    }
+    return lengthStart[length];
+}
+
+int MappedWordGraph::countOfLength(int length) const {
+    if (length <= 0 || length > maxLength) {
+        return 0;
+    }
+    return lengthStart[length + 1] - lengthStart[length];
+}
+
+int MappedWordGraph::neighbourCount(int id) const {
+    return neighbourStart[id + 1] - neighbourStart[id];
+}
+
+/*
+ * Function: checkArrays
+ * Usage:
+ * Checks that the offset arrays of the payload only ever grow and end where the arrays they index
+ * end, and that every neighbour is a word ID. The checksum only catches accidental damage, and
+ * lookups, searches and ComponentLabels all index by these numbers without checking them again
+ * Params: neighbourCount (uint32_t, the length of the neighbours array given in the header)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: true if the arrays can be trusted
+*/
+bool MappedWordGraph::checkArrays(uint32_t neighbourCount) const {
+    if (lengthStart[0] != 0 || lengthStart[1] != 0
+            || lengthStart[maxLength + 1] != (uint32_t) wordCount) {
+        return false;
+    }
+    for (int length = 1; length <= maxLength; length++) {
+        if (lengthStart[length + 1] < lengthStart[length]) {
+            return false;
+        }
+    }
+    if (neighbourStart[0] != 0 || neighbourStart[wordCount] != neighbourCount) {
+        return false;
+    }
+    for (int id = 0; id < wordCount; id++) {
+        if (neighbourStart[id + 1] < neighbourStart[id]) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < neighbourCount; i++) {
+        if (neighbours[i] >= (uint32_t) wordCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Function: lengthOf
+ * Usage:
+ * Finds a word's length from the range of IDs its ID falls in
+ * Params: id (int)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the length of the word with the given ID
+*/
+int MappedWordGraph::lengthOf(int id) const {
+    // The first length whose range starts after the ID is one past the word's length
+    return upper_bound(lengthStart, lengthStart + maxLength + 2, (uint32_t) id) - lengthStart - 1;
+}
+
+/*
+ * Function: lettersOf
+ * Usage:
+ * Finds a word's letters in the file. They are not followed by a zero byte
+ * Params: id (int), length (int, the word's length)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: a pointer to the first letter
+*/
+const char *MappedWordGraph::lettersOf(int id, int length) const {
+    return letters + letterStart[length] + (size_t) (id - lengthStart[length]) * length;
+}
+
+/*
+ * Function: unmap
+ * Usage:
+ * Releases the mapping or buffer holding the file
+ * Params: None
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+void MappedWordGraph::unmap() {
+#ifndef _WIN32
+    if (data != nullptr) {
+        munmap((void *) data, dataSize);
+    }
+#endif
+    data = nullptr;
+    buffer.clear();
+}
+
+bool isGraphFile(const string &filename) {
+    ifstream input(filename.c_str(), ios::binary);
+    char magic[8];
+    return input.read(magic, 8) && memcmp(magic, GRAPH_FILE_MAGIC, 8) == 0;
+}
+
+void writeGraphFile(const WordGraph &graph, const string &filename) {
+    int maxLength = 0;
+    while (graph.firstIdOfLength(maxLength + 1) < graph.size()) {
+        maxLength++;
+    }
+
+    // Lay the payload out in memory first, so it can be checksummed before the header is written
+    vector<uint32_t> numbers;
+    for (int length = 0; length <= maxLength + 1; length++) {
+        numbers.push_back(length == 0 ? 0 : graph.firstIdOfLength(length));
+    }
+    uint32_t neighbourCount = 0;
+    for (int id = 0; id <= graph.size(); id++) {
+        numbers.push_back(neighbourCount);
+        if (id < graph.size()) {
+            neighbourCount += graph.neighbourCount(id);
+        }
+    }
+    for (int id = 0; id < graph.size(); id++) {
+        graph.mapNeighbours(id, [&numbers](int neighbourWord) {
+            numbers.push_back(neighbourWord);
+        });
+    }
+    string payload((const char *) numbers.data(), numbers.size() * sizeof(uint32_t));
+    for (int id = 0; id < graph.size(); id++) {
+        payload += graph.wordAt(id);
+    }
+
+    GraphFileHeader header;
+    memcpy(header.magic, GRAPH_FILE_MAGIC, 8);
+    header.version = GRAPH_FILE_VERSION;
+    header.byteOrder = GRAPH_FILE_BYTE_ORDER;
+    header.wordCount = graph.size();
+    header.maxLength = maxLength;
+    header.neighbourCount = neighbourCount;
+    header.reserved = 0;
+    header.payloadSize = payload.size();
+    header.checksum = checksum(payload.data(), payload.size());
+
+    ofstream output(filename.c_str(), ios::binary);
+    output.write((const char *) &header, sizeof(header));
+    output.write(payload.data(), payload.size());
+    output.close();
+    if (output.fail()) {
+        error("writeGraphFile: Can't write graph file " + filename);
+    }
+}
+
+/*
+ * Function: checksum
+ * Usage:
+ * Hashes bytes with 64-bit FNV-1a, which is quick enough to check a whole graph file on every
+ * start and catches truncated or overwritten files
+ * Params: bytes (pointer to the first byte), size (number of bytes)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the hash
+*/
+static uint64_t checksum(const char *bytes, size_t size) {
+    uint64_t hash = UINT64_C(14695981039346656037);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char) bytes[i];
+        hash *= UINT64_C(1099511628211);
+    }
+    return hash;
+}
@@ -0,0 +1,136 @@
+/*
+* This file declares the word ladder graph file, a binary file holding everything a search needs:
+* the words, where each word length starts, and the CSR neighbour arrays of a WordGraph. A graph
+* file is written once with writeGraphFile, then MappedWordGraph maps it into memory and searches
+* the arrays in place, so a process that starts from a graph file skips reading the dictionary
+* into a Lexicon and building the graph.
+*
+* The file is a 48-byte header followed by the payload. All numbers are unsigned 32-bit integers
+* in the byte order of the machine that wrote the file, except the two 64-bit fields:
+*   magic           8 bytes, "WLGRAPH" and a zero byte
+*   version         1, bumped whenever the layout changes
+*   byteOrder       0x01020304, to reject files written on a machine with the other byte order
+*   wordCount
+*   maxLength       length of the longest word
+*   neighbourCount  length of the neighbours array, i.e. twice the number of neighbour pairs
+*   reserved        0
+*   payloadSize     64-bit, bytes after the header
+*   checksum        64-bit FNV-1a hash of the payload
+* The payload holds, in order:
+*   lengthStart     maxLength + 2 integers, as in WordList
+*   neighbourStart  wordCount + 1 integers, as in WordGraph
+*   neighbours      neighbourCount integers
+*   letters         the words without separators, ordered by ID. The words of one length all take
+*                   the same space, so a word's letters are found from its ID alone
+*/
+
+#ifndef _graphfile_h
+#define _graphfile_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "wordgraph.h"
+
+class MappedWordGraph {
+public:
+    /*
+     * Constructor: MappedWordGraph
+     * Usage: MappedWordGraph graph(filename);
+     * Maps a graph file into memory. Signals an error if the file can't be read, isn't a graph
+     * file, has a different version or byte order, fails its checksum, or holds offsets or word
+     * IDs that point outside its arrays
+     * Params: filename (string)
+     * ---------------------------------------------------------------------------------------------
+     */
+    MappedWordGraph(const std::string &filename);
+
+    /*
+     * Destructor: ~MappedWordGraph
+     * Unmaps the file
+     * ---------------------------------------------------------------------------------------------
+     */
+    ~MappedWordGraph();
+
+    /*
+     * Method: contains
+     * Usage: if (graph.contains(word)) ...
+     * Lets a graph stand in for the Lexicon it was built from when checking words
+     * Params: word (string, in lowercase)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: true if the word is in the graph
+     */
+    bool contains(const std::string &word) const;
+
+    /*
+     * Methods: indexOf, wordAt, size, firstIdOfLength, countOfLength
+     * These work as in WordList. wordAt returns a copy, as the letters in the file are not
+     * stored as strings
+     * ---------------------------------------------------------------------------------------------
+     */
+    int indexOf(const std::string &word) const;
+    std::string wordAt(int id) const;
+    int size() const;
+    int firstIdOfLength(int length) const;
+    int countOfLength(int length) const;
+
+    /*
+     * Methods: neighbourCount, mapNeighbours
+     * These work as in WordGraph, reading the neighbour arrays straight from the file
+     * ---------------------------------------------------------------------------------------------
+     */
+    int neighbourCount(int id) const;
+    template <typename FunctorType>
+    void mapNeighbours(int id, FunctorType fn) const;
+
+private:
+    bool checkArrays(uint32_t neighbourCount) const;
+    int lengthOf(int id) const;
+    const char *lettersOf(int id, int length) const;
+    void unmap();
+
+    /* instance variables */
+    const char *data;                // start of the mapped file
+    size_t dataSize;
+    std::vector<char> buffer;        // the file's contents where it can't be mapped
+    int wordCount;
+    int maxLength;
+    const uint32_t *lengthStart;     // arrays of the payload, pointing into the mapped file
+    const uint32_t *neighbourStart;
+    const uint32_t *neighbours;
+    const char *letters;
+    std::vector<size_t> letterStart;  // letterStart[L] is where the letters of length L start
+
+    // Copying a graph would mean mapping the file again
+    MappedWordGraph(const MappedWordGraph &) = delete;
+    MappedWordGraph &operator =(const MappedWordGraph &) = delete;
+};
+
+/*
+ * Function: isGraphFile
+ * Usage: if (isGraphFile(filename)) ...
+ * Params: filename (string)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: true if the file exists and starts with the graph file magic
+*/
+bool isGraphFile(const std::string &filename);
+
+/*
+ * Function: writeGraphFile
+ * Usage: writeGraphFile(graph, filename);
+ * Writes a graph to a graph file. Signals an error if the file can't be written
+ * Params: graph (WordGraph), filename (string)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+void writeGraphFile(const WordGraph &graph, const std::string &filename);
+
+template <typename FunctorType>
+void MappedWordGraph::mapNeighbours(int id, FunctorType fn) const {
+    uint32_t end = neighbourStart[id + 1];
+    for (uint32_t i = neighbourStart[id]; i < end; i++) {
+        fn((int) neighbours[i]);
+    }
+}
+
+#endif // _graphfile_h
@@ -0,0 +1,60 @@
+/*
+* This is the implementation of the LadderTable class. The tables only cover the words of the
+* source's length, since no other word can be on a ladder from it.
+*/
+
+#include "laddertable.h"
+#include "error.h"
+#include "strlib.h"
+using namespace std;
+
+int LadderTable::source() const {
+    return sourceId;
+}
+
+int LadderTable::reachableCount() const {
+    return reached;
+}
+
+bool LadderTable::isReachable(int id) const {
+    return distanceTo(id) != -1;
+}
+
+int LadderTable::distanceTo(int id) const {
+    int slot = slotOf(id);
+    return slot == -1 ? -1 : distances[slot];
+}
+
+int LadderTable::previousWord(int id) const {
+    int slot = slotOf(id);
+    return slot == -1 ? -1 : previousWords[slot];
+}
+
+void LadderTable::getLadder(int id, Stack<int> &ladder) const {
+    if (!isReachable(id)) {
+        error("LadderTable::getLadder: word " + integerToString(id) + " is not reachable");
+    }
+    // Walk back from the word to the source, then push the words in ladder order
+    Stack<int> reversedLadder;
+    for (int word = id; word != sourceId; word = previousWords[word - firstId]) {
+        reversedLadder.push(word);
+    }
+    ladder.push(sourceId);
+    while (!reversedLadder.isEmpty()) {
+        ladder.push(reversedLadder.pop());
+    }
+}
+
+/*
+ * Function: slotOf
+ * Usage:
+ * Finds where a word's entries are in the tables
+ * Params: id (int)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the index of the word's entries, or -1 if the word has a different length from the
+ * source
+*/
+int LadderTable::slotOf(int id) const {
+    int slot = id - firstId;
+    return slot >= 0 && slot < (int) distances.size() ? slot : -1;
+}
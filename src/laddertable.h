@@ -0,0 +1,128 @@
+/*
+* This file declares the LadderTable class, the result of one full breadth-first search from a
+* source word. The search runs over the words of the source's length until every word it can reach
+* has been reached, and records each word's distance from the source and the word it was first
+* reached from. After that, the shortest ladder from the source to any word of that length is
+* found by following the recorded words back to the source, without searching again, so many
+* queries that share word 1 only cost one search.
+*/
+
+#ifndef _laddertable_h
+#define _laddertable_h
+
+#include <vector>
+#include "queue.h"
+#include "stack.h"
+
+class LadderTable {
+public:
+    /*
+     * Constructor: LadderTable
+     * Usage: LadderTable table(index, source);
+     * Runs a breadth-first search from the word with the given ID over a neighbour index (a
+     * WordGraph or WildcardIndex). Neighbours are reached in the same order as in the single-pair
+     * search, so the ladders in the table are the ones that search would find
+     * Params: index (WordGraph or WildcardIndex), source (int)
+     * ---------------------------------------------------------------------------------------------
+     */
+    template <typename NeighbourIndex>
+    LadderTable(const NeighbourIndex &index, int source);
+
+    /*
+     * Method: source
+     * Usage: int id = table.source();
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the ID of the word the search started from
+     */
+    int source() const;
+
+    /*
+     * Method: reachableCount
+     * Usage: int n = table.reachableCount();
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the number of words reachable from the source, including the source itself
+     */
+    int reachableCount() const;
+
+    /*
+     * Method: isReachable
+     * Usage: if (table.isReachable(id)) ...
+     * Params: id (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: true if there is a ladder from the source to the word with the given ID
+     */
+    bool isReachable(int id) const;
+
+    /*
+     * Method: distanceTo
+     * Usage: int steps = table.distanceTo(id);
+     * Params: id (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the number of one-letter changes on a shortest ladder from the source to the word
+     * with the given ID, or -1 if there is no ladder
+     */
+    int distanceTo(int id) const;
+
+    /*
+     * Method: previousWord
+     * Usage: int id = table.previousWord(id);
+     * Params: id (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the word before the given word on its shortest ladder from the source, the source
+     * itself for the source, or -1 if there is no ladder
+     */
+    int previousWord(int id) const;
+
+    /*
+     * Method: getLadder
+     * Usage: table.getLadder(id, ladder);
+     * Pushes the shortest ladder from the source to the given word onto a stack, in O(ladder
+     * length). Signals an error if the word is not reachable
+     * Params: id (int), ladder (Stack of word IDs, filled with the source at the bottom and the
+     * given word on top)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: None. Void function
+     */
+    void getLadder(int id, Stack<int> &ladder) const;
+
+private:
+    int slotOf(int id) const;
+
+    /* instance variables */
+    int sourceId;
+    int firstId;                     // ID of the first word of the source's length; the tables
+                                     // below are indexed by ID - firstId
+    int reached;                     // number of words reachable from the source
+    std::vector<int> distances;      // steps from the source, or -1 if not reachable
+    std::vector<int> previousWords;  // the word each word was first reached from, or -1
+};
+
+template <typename NeighbourIndex>
+LadderTable::LadderTable(const NeighbourIndex &index, int source) : sourceId(source), reached(1) {
+    int length = index.wordAt(source).length();
+    firstId = index.firstIdOfLength(length);
+    distances.assign(index.countOfLength(length), -1);
+    previousWords.assign(index.countOfLength(length), -1);
+    distances[source - firstId] = 0;
+    previousWords[source - firstId] = source;
+
+    // Search until every reachable word has been expanded instead of stopping at a word 2. Each
+    // word is queued at most once, so room for the whole length means the queue never grows
+    Queue<int> queue;
+    queue.reserve(distances.size());
+    queue.enqueue(source);
+    while (!queue.isEmpty()) {
+        int word = queue.dequeue();
+        int nextDistance = distances[word - firstId] + 1;
+        index.mapNeighbours(word, [&](int neighbourWord) {
+            if (distances[neighbourWord - firstId] == -1) {
+                distances[neighbourWord - firstId] = nextDistance;
+                previousWords[neighbourWord - firstId] = word;
+                queue.enqueue(neighbourWord);
+                reached++;
+            }
+        });
+    }
+}
+
+#endif // _laddertable_h
@@ -0,0 +1,135 @@
+/*
+* This is the implementation of the LengthShardedLexicon class. A shard is loaded by reading the
+* whole dictionary file again and keeping only the words of its length, so nothing but the shards
+* themselves is held between loads. A binary DAWG file is mapped rather than read, which makes
+* loading a shard from one much cheaper than from a word list.
+*/
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "lengthshardedlexicon.h"
+#include "dawglexicon.h"
+#include "error.h"
+#include "strlib.h"
+using namespace std;
+
+static bool isDawgFile(const string &filename);
+
+LengthShardedLexicon::LengthShardedLexicon(const string &filename, int maxWords)
+        : filename(filename), maxWords(maxWords), useCount(0), heldWords(0) {
+    ifstream input(filename.c_str());
+    if (input.fail()) {
+        error("LengthShardedLexicon: Can't open dictionary file " + filename);
+    }
+}
+
+bool LengthShardedLexicon::contains(const string &word) const {
+    return !word.empty() && shard(word.length())->contains(word);
+}
+
+shared_ptr<const Lexicon> LengthShardedLexicon::shard(int length) const {
+    if (length >= (int) shards.size()) {
+        shards.resize(length + 1);
+        lastUsed.resize(length + 1, 0);
+    }
+    lastUsed[length] = ++useCount;
+    if (!shards[length]) {
+        shards[length] = loadShard(length);
+        heldWords += shards[length]->size();
+        evictLeastRecentlyUsed(length);
+    }
+    return shards[length];
+}
+
+void LengthShardedLexicon::evict(int length) {
+    if (length < (int) shards.size() && shards[length]) {
+        heldWords -= shards[length]->size();
+        shards[length].reset();
+    }
+}
+
+int LengthShardedLexicon::heldShardCount() const {
+    int count = 0;
+    for (const shared_ptr<const Lexicon> &held : shards) {
+        if (held) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int LengthShardedLexicon::heldWordCount() const {
+    return heldWords;
+}
+
+/*
+ * Function: loadShard
+ * Usage:
+ * Reads the words of one length from the dictionary file into a new Lexicon. The words are passed
+ * to the Lexicon as a word list in file order, so a sorted dictionary still loads in one pass
+ * Params: length (int)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the shard
+*/
+shared_ptr<const Lexicon> LengthShardedLexicon::loadShard(int length) const {
+    ostringstream words;
+    if (isDawgFile(filename)) {
+        DawgLexicon dawg(filename);
+        for (const string &word : dawg) {
+            if ((int) word.length() == length) {
+                words << word << '\n';
+            }
+        }
+    } else {
+        ifstream input(filename.c_str());
+        string line;
+        while (getline(input, line)) {
+            string word = trim(line);
+            if ((int) word.length() == length) {
+                words << word << '\n';
+            }
+        }
+    }
+    istringstream wordList(words.str());
+    return make_shared<const Lexicon>(wordList);
+}
+
+/*
+ * Function: evictLeastRecentlyUsed
+ * Usage:
+ * Drops the shards used longest ago until the words held fit the budget, never dropping the shard
+ * of the given length, which has just been asked for
+ * Params: keepLength (int)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+void LengthShardedLexicon::evictLeastRecentlyUsed(int keepLength) const {
+    while (maxWords > 0 && heldWords > maxWords) {
+        int oldest = -1;
+        for (int length = 0; length < (int) shards.size(); length++) {
+            if (shards[length] && length != keepLength
+                    && (oldest == -1 || lastUsed[length] < lastUsed[oldest])) {
+                oldest = length;
+            }
+        }
+        if (oldest == -1) {
+            return;
+        }
+        heldWords -= shards[oldest]->size();
+        shards[oldest].reset();
+    }
+}
+
+/*
+ * Function: isDawgFile
+ * Usage:
+ * Params: filename (string)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: true if the file starts like a binary DAWG lexicon
+*/
+static bool isDawgFile(const string &filename) {
+    ifstream input(filename.c_str(), ios::binary);
+    char magic[4];
+    return input.read(magic, 4) && memcmp(magic, "DAWG", 4) == 0;
+}
@@ -0,0 +1,86 @@
+/*
+* This file declares the LengthShardedLexicon class, a dictionary split up by word length. A word
+* ladder never changes the length of its words, so a batch only needs the words of the lengths its
+* pairs ask for. The words of each length are kept in a Lexicon of their own (a shard), which is
+* only loaded from the dictionary file the first time a word of that length is looked up. Once
+* the shards held add up to more words than a budget allows, the shards used longest ago are
+* dropped, to be loaded again if they are needed later.
+*/
+
+#ifndef _lengthshardedlexicon_h
+#define _lengthshardedlexicon_h
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "lexicon.h"
+
+class LengthShardedLexicon {
+public:
+    /*
+     * Constructor: LengthShardedLexicon
+     * Usage: LengthShardedLexicon dictionary(filename);
+     *        LengthShardedLexicon dictionary(filename, maxWords);
+     * Opens a dictionary, a word list or a binary DAWG lexicon, without loading any words yet.
+     * Signals an error if the file can't be opened
+     * Params: filename (string), maxWords (int, the most words the shards may hold together before
+     * the least recently used are dropped, or 0 for no limit)
+     * ---------------------------------------------------------------------------------------------
+     */
+    LengthShardedLexicon(const std::string &filename, int maxWords = 0);
+
+    /*
+     * Method: contains
+     * Usage: if (dictionary.contains(word)) ...
+     * Looks a word up in the shard of its length, loading the shard first if it isn't held
+     * Params: word (string)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: true if the word is in the dictionary
+     */
+    bool contains(const std::string &word) const;
+
+    /*
+     * Method: shard
+     * Usage: shared_ptr<const Lexicon> words = dictionary.shard(length);
+     * Loads the shard of the given length if it isn't held. The shard stays valid for as long as
+     * the pointer is kept, even if the dictionary drops it in the meantime
+     * Params: length (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the words of the given length
+     */
+    std::shared_ptr<const Lexicon> shard(int length) const;
+
+    /*
+     * Method: evict
+     * Usage: dictionary.evict(length);
+     * Drops the shard of the given length, if it is held
+     * Params: length (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: None. Void function
+     */
+    void evict(int length);
+
+    /*
+     * Methods: heldShardCount, heldWordCount
+     * These count the shards held and the words in them, to check the budget is doing its job
+     * ---------------------------------------------------------------------------------------------
+     */
+    int heldShardCount() const;
+    int heldWordCount() const;
+
+private:
+    std::shared_ptr<const Lexicon> loadShard(int length) const;
+    void evictLeastRecentlyUsed(int keepLength) const;
+
+    /* instance variables */
+    std::string filename;
+    int maxWords;
+    // Shards are loaded and dropped by const lookups, so a LengthShardedLexicon can stand in for
+    // a Lexicon. Lookups must therefore not be made from several threads at once
+    mutable std::vector<std::shared_ptr<const Lexicon>> shards;  // shards[L], or null if not held
+    mutable std::vector<long> lastUsed;  // lastUsed[L] is when shards[L] was last looked up
+    mutable long useCount;
+    mutable int heldWords;
+};
+
+#endif // _lengthshardedlexicon_h
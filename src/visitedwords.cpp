@@ -0,0 +1,22 @@
+/*
+* This is the implementation of the VisitedWords class.
+*/
+
+#include <algorithm>
+#include "visitedwords.h"
+using namespace std;
+
+VisitedWords::VisitedWords() : epoch(0) {
+}
+
+void VisitedWords::reset(int size) {
+    if ((int) stamps.size() < size) {
+        stamps.resize(size, 0);
+    }
+    epoch++;
+    if (epoch == 0) {
+        // The epoch has wrapped round, so old stamps could match again: wipe them once
+        fill(stamps.begin(), stamps.end(), 0);
+        epoch = 1;
+    }
+}
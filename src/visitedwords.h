@@ -0,0 +1,68 @@
+/*
+* This file declares the VisitedWords class, the set of words a search has reached so far. Each
+* word ID has a stamp, and a word is in the set when its stamp matches the current epoch. Starting
+* the next search only bumps the epoch, which forgets every word at once, so a thread can run
+* search after search over the same words without ever clearing or reallocating the stamps.
+*/
+
+#ifndef _visitedwords_h
+#define _visitedwords_h
+
+#include <cstdint>
+#include <vector>
+
+class VisitedWords {
+public:
+    /*
+     * Constructor: VisitedWords
+     * Usage: VisitedWords visited;
+     * Creates the set with no stamps. reset must be called before any word is added
+     * ---------------------------------------------------------------------------------------------
+     */
+    VisitedWords();
+
+    /*
+     * Method: reset
+     * Usage: visited.reset(index.size());
+     * Empties the set for a new search over word IDs 0 to size - 1. This takes O(1) unless there
+     * are more IDs than in any earlier search, or the epoch has run through all 2^32 values
+     * Params: size (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: None. Void function
+     */
+    void reset(int size);
+
+    /*
+     * Method: contains
+     * Usage: if (visited.contains(id)) ...
+     * Params: id (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: true if the word with the given ID has been added since the last reset
+     */
+    bool contains(int id) const;
+
+    /*
+     * Method: add
+     * Usage: visited.add(id);
+     * Params: id (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: None. Void function
+     */
+    void add(int id);
+
+private:
+    /* instance variables */
+    std::vector<uint32_t> stamps;  // stamps[id] is the epoch in which the word was last added
+    uint32_t epoch;                // the current search; 0 is never a search, so new stamps are
+                                   // never in the set
+};
+
+inline bool VisitedWords::contains(int id) const {
+    return stamps[id] == epoch;
+}
+
+inline void VisitedWords::add(int id) {
+    stamps[id] = epoch;
+}
+
+#endif // _visitedwords_h
@@ -0,0 +1,134 @@
+/*
+* This is the implementation of the WildcardIndex class. The index is built in two passes over the
+* words: the first counts how many words are filed under each pattern, which lays the buckets
+* out back to back in one array, and the second fills the buckets. Words are visited in ID order,
+* so each bucket ends up in alphabetical order.
+*/
+
+#include "wildcardindex.h"
+#include "hashcode.h"
+using namespace std;
+
+static void patternHashCodes(const string &word, vector<int> &hashes);
+
+WildcardIndex::WildcardIndex(const Lexicon &dictionary, int length)
+        : WordList(dictionary, length) {
+    buildBuckets();
+}
+
+/*
+ * Function: findSlot
+ * Usage:
+ * Finds the hash table slot of the pattern formed by putting a wildcard at the given position of
+ * the word with the given ID, using linear probing
+ * Params: id (int), position (int), hash (the pattern's hash code)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the index of the pattern's slot, or of the empty slot where it belongs
+*/
+int WildcardIndex::findSlot(int id, int position, int hash) const {
+    const string &word = words[id];
+    // Scramble the hash so that the low bits used to pick a slot depend on every letter
+    unsigned int scrambled = hash * 2654435769u;
+    int index = (scrambled ^ (scrambled >> 16)) & slotMask;
+    while (true) {
+        const Slot &slot = slots[index];
+        if (slot.word == -1
+                || (slot.hash == hash
+                    && slot.position == position
+                    && words[slot.word].length() == word.length()
+                    && compareExceptAt(words[slot.word], word, position) == 0)) {
+            return index;
+        }
+        index = (index + 1) & slotMask;
+    }
+}
+
+/*
+ * Function: buildBuckets
+ * Usage:
+ * Files every word under each of its wildcard patterns
+ * Params: None
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+void WildcardIndex::buildBuckets() {
+    // Number the patterns: the L patterns of each word are consecutive, in ID order
+    patternStart = vector<int>(lengthStart.size(), 0);
+    for (int length = 1; length < (int) lengthStart.size(); length++) {
+        int wordCount = lengthStart[length] - lengthStart[length - 1];
+        patternStart[length] = patternStart[length - 1] + wordCount * (length - 1);
+    }
+    int patternCount = patternStart[lengthStart.size() - 1];
+
+    // Size the table to a power of two that keeps it at most two thirds full
+    int capacity = 1;
+    while (capacity < patternCount + patternCount / 2 + 1) {
+        capacity *= 2;
+    }
+    Slot empty = {-1, 0, 0, 0, 0};
+    slots = vector<Slot>(capacity, empty);
+    slotMask = capacity - 1;
+
+    // First pass: count the words filed under each pattern, remembering each pattern's slot
+    patternSlots = vector<int>(patternCount, 0);
+    vector<int> hashes;
+    for (int id = 0; id < size(); id++) {
+        patternHashCodes(words[id], hashes);
+        for (int position = 0; position < (int) words[id].length(); position++) {
+            int index = findSlot(id, position, hashes[position]);
+            Slot &slot = slots[index];
+            if (slot.word == -1) {
+                slot.word = id;
+                slot.position = position;
+                slot.hash = hashes[position];
+            }
+            slot.size++;
+            patternSlots[patternIndex(id, position)] = index;
+        }
+    }
+
+    // Lay the buckets out back to back, then empty them again for filling
+    int start = 0;
+    for (int index = 0; index < (int) slots.size(); index++) {
+        slots[index].start = start;
+        start += slots[index].size;
+        slots[index].size = 0;
+    }
+
+    // Second pass: fill each bucket in ID order
+    members = vector<int>(start, 0);
+    for (int id = 0; id < size(); id++) {
+        for (int position = 0; position < (int) words[id].length(); position++) {
+            Slot &slot = slots[patternSlots[patternIndex(id, position)]];
+            members[slot.start + slot.size] = id;
+            slot.size++;
+        }
+    }
+}
+
+/*
+ * Function: patternHashCodes
+ * Usage:
+ * Hashes each of the wildcard patterns of a word, in the same way hashCodeDjb2 hashes a string.
+ * That hash is a polynomial in the letters, so each pattern's hash is the whole word's hash with
+ * one term swapped for the wildcard, and all L hashes cost O(L) instead of O(L^2). The default
+ * word-at-a-time string hash mixes whole words of letters and can't be updated like this
+ * Params: word (string), hashes (vector of ints, filled with the hash code for each position)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+static void patternHashCodes(const string &word, vector<int> &hashes) {
+    unsigned multiplier = hashMultiplier();
+    int n = word.length();
+    unsigned hash = hashSeed();
+    for (int i = 0; i < n; i++) {
+        hash = multiplier * hash + word[i];
+    }
+    // The letter at position i is multiplied by multiplier^(n - 1 - i) in the word's hash
+    hashes.resize(n);
+    unsigned power = 1;
+    for (int i = n - 1; i >= 0; i--) {
+        hashes[i] = int((hash - power * (word[i] - '*')) & hashMask());
+        power *= multiplier;
+    }
+}
@@ -0,0 +1,89 @@
+/*
+* This file declares the WildcardIndex class, a cheaper alternative to WordGraph for finding the
+* neighbours of a word. Instead of storing every neighbour pair, each word is filed under its L
+* wildcard patterns, e.g. code is filed under *ode, c*de, co*e and cod*. Words that share a
+* pattern are exactly the neighbours that differ at the wildcard, so the neighbours of a word are
+* found by scanning its L pattern buckets. Buckets live in one flat open-addressing hash table
+* and one flat array of word IDs, so building the index costs L hash insertions per word and no
+* per-word allocations. The slot of each of a word's patterns is remembered, so looking up
+* neighbours needs no hashing at all.
+*/
+
+#ifndef _wildcardindex_h
+#define _wildcardindex_h
+
+#include <vector>
+#include "lexicon.h"
+#include "wordlist.h"
+
+class WildcardIndex : public WordList {
+public:
+    /*
+     * Constructor: WildcardIndex
+     * Usage: WildcardIndex index(dictionary);
+     *        WildcardIndex index(dictionary, length);
+     * Files every word in the given dictionary under its wildcard patterns, or only the words of
+     * the given length if one is given
+     * Params: dictionary (Lexicon), length (int, 0 for every length)
+     * ---------------------------------------------------------------------------------------------
+     */
+    WildcardIndex(const Lexicon &dictionary, int length = 0);
+
+    /*
+     * Method: mapNeighbours
+     * Usage: index.mapNeighbours(id, fn);
+     * Calls fn(neighbourId) on each one-letter neighbour of the word with the given ID. Neighbours
+     * are visited in the same order as the classic search generates them: by the index of the
+     * changed letter, then from 'a' to 'z'
+     * Params: id (int), fn (function taking an int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: None. Void function
+     */
+    template <typename FunctorType>
+    void mapNeighbours(int id, FunctorType fn) const;
+
+private:
+    /*
+     * A slot of the pattern hash table. The pattern is identified by a word filed under it and
+     * the position of the wildcard; its bucket is members[start .. start + size - 1]
+     */
+    struct Slot {
+        int word;       // ID of the first word filed under the pattern, or -1 if the slot is empty
+        int position;   // index of the wildcard letter
+        int hash;       // hash code of the pattern, checked before comparing any letters
+        int start;
+        int size;
+    };
+
+    int findSlot(int id, int position, int hash) const;
+    int patternIndex(int id, int position) const;
+    void buildBuckets();
+
+    /* instance variables */
+    std::vector<Slot> slots;        // open-addressing hash table of patterns, size is a power of 2
+    int slotMask;                   // slots.size() - 1
+    std::vector<int> members;       // word IDs of every bucket, each bucket in alphabetical order
+    std::vector<int> patternStart;  // patternStart[L] is the pattern index of the first word of
+                                    // length L; a word's L patterns have consecutive indexes
+    std::vector<int> patternSlots;  // slot of each pattern of each word, by pattern index
+};
+
+inline int WildcardIndex::patternIndex(int id, int position) const {
+    int length = wordAt(id).length();
+    return patternStart[length] + (id - lengthStart[length]) * length + position;
+}
+
+template <typename FunctorType>
+void WildcardIndex::mapNeighbours(int id, FunctorType fn) const {
+    int length = wordAt(id).length();
+    for (int position = 0; position < length; position++) {
+        const Slot &slot = slots[patternSlots[patternIndex(id, position)]];
+        for (int i = slot.start; i < slot.start + slot.size; i++) {
+            if (members[i] != id) {
+                fn(members[i]);
+            }
+        }
+    }
+}
+
+#endif // _wildcardindex_h
@@ -0,0 +1,139 @@
+/*
+* This is the implementation of the WordGraph class. The graph is built in two steps:
+* 1. The WordList lays the words out by length, then alphabetically, which gives each word its ID
+* 2. For each word length and each letter position i, the words of that length are sorted with
+*    the letter at position i ignored. Words that end up next to each other with equal keys only
+*    differ at position i, so each run of equal keys is a group of mutual neighbours
+* This finds every neighbour pair with L sorts per length instead of 26 x L dictionary lookups
+* per word.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "wordgraph.h"
+using namespace std;
+
+// Longest word whose letters, less one, fit in a 64-bit key at 5 bits per letter
+static const int MAX_PACKED_LENGTH = 13;
+
+static uint64_t packExceptAt(const string &word, int position);
+
+WordGraph::WordGraph(const Lexicon &dictionary, int length) : WordList(dictionary, length) {
+    buildAdjacency();
+}
+
+int WordGraph::neighbourCount(int id) const {
+    return neighbourStart[id + 1] - neighbourStart[id];
+}
+
+/*
+ * Function: buildAdjacency
+ * Usage:
+ * Fills the CSR adjacency arrays. Positions are processed in order and each run of equal keys is
+ * sorted alphabetically, so every word's neighbours come out ordered by changed position, then
+ * by letter
+ * Params: None
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+void WordGraph::buildAdjacency() {
+    neighbourStart = vector<int>(words.size() + 1, 0);
+    neighbours.clear();
+
+    for (int length = 1; length + 1 < (int) lengthStart.size(); length++) {
+        int first = lengthStart[length];
+        int last = lengthStart[length + 1];
+        // Sort the IDs once per letter position, ignoring the letter at that position
+        const string *wordArray = words.data();
+        vector<vector<int>> orders(length);
+        for (int position = 0; position < length; position++) {
+            vector<int> &order = orders[position];
+            if (length <= MAX_PACKED_LENGTH) {
+                // Short words sort much faster as packed integer keys than as strings
+                vector<pair<uint64_t, int>> keys;
+                for (int id = first; id < last; id++) {
+                    keys.push_back(make_pair(packExceptAt(wordArray[id], position), id));
+                }
+                sort(keys.begin(), keys.end());
+                for (const pair<uint64_t, int> &key : keys) {
+                    order.push_back(key.second);
+                }
+            } else {
+                for (int id = first; id < last; id++) {
+                    order.push_back(id);
+                }
+                sort(order.begin(), order.end(), [wordArray, position](int a, int b) {
+                    int comparison = compareExceptAt(wordArray[a], wordArray[b], position);
+                    return comparison < 0 || (comparison == 0 && a < b);
+                });
+            }
+        }
+
+        // Each run of IDs whose words are equal apart from the given position
+        auto endOfRun = [wordArray](const vector<int> &order, int runStart, int position) {
+            int runEnd = runStart + 1;
+            while (runEnd < (int) order.size()
+                   && compareExceptAt(wordArray[order[runStart]], wordArray[order[runEnd]],
+                                      position) == 0) {
+                runEnd++;
+            }
+            return runEnd;
+        };
+
+        // First pass: count the neighbours of each word so the CSR offsets can be laid out
+        vector<int> degree(last - first, 0);
+        for (int position = 0; position < length; position++) {
+            const vector<int> &order = orders[position];
+            for (int runStart = 0, runEnd = 0; runStart < (int) order.size(); runStart = runEnd) {
+                runEnd = endOfRun(order, runStart, position);
+                for (int k = runStart; k < runEnd; k++) {
+                    degree[order[k] - first] += runEnd - runStart - 1;
+                }
+            }
+        }
+        for (int id = first; id < last; id++) {
+            neighbourStart[id + 1] = neighbourStart[id] + degree[id - first];
+        }
+
+        // Second pass: write each run of mutual neighbours into the CSR column array
+        int total = neighbourStart[last];
+        neighbours.resize(total);
+        vector<int> cursor(last - first);
+        for (int id = first; id < last; id++) {
+            cursor[id - first] = neighbourStart[id];
+        }
+        for (int position = 0; position < length; position++) {
+            const vector<int> &order = orders[position];
+            for (int runStart = 0, runEnd = 0; runStart < (int) order.size(); runStart = runEnd) {
+                runEnd = endOfRun(order, runStart, position);
+                for (int k = runStart; k < runEnd; k++) {
+                    for (int j = runStart; j < runEnd; j++) {
+                        if (j != k) {
+                            neighbours[cursor[order[k] - first]++] = order[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Function: packExceptAt
+ * Usage:
+ * Packs a word of at most MAX_PACKED_LENGTH letters into an integer, 5 bits per letter, with the
+ * letter at the given position left out. Integer order matches the order of compareExceptAt
+ * Params: word (string), position (int)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the packed key
+*/
+static uint64_t packExceptAt(const string &word, int position) {
+    uint64_t key = 0;
+    for (int i = 0; i < (int) word.length(); i++) {
+        if (i != position) {
+            key = (key << 5) | (uint64_t) (word[i] - 'a' + 1);
+        }
+    }
+    return key;
+}
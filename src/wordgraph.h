@@ -0,0 +1,69 @@
+/*
+* This file declares the WordGraph class, a precomputed neighbour graph over the words of a
+* dictionary. Two words are neighbours when they have the same length and differ by exactly one
+* letter, e.g. date and data. Words are numbered by the WordList the graph extends, and the
+* one-letter neighbours of every word are stored once in a compressed sparse row (CSR) adjacency
+* array, so a word ladder search can walk the graph by ID instead of building and looking up
+* 26 x L candidate strings per word.
+*/
+
+#ifndef _wordgraph_h
+#define _wordgraph_h
+
+#include <vector>
+#include "lexicon.h"
+#include "wordlist.h"
+
+class WordGraph : public WordList {
+public:
+    /*
+     * Constructor: WordGraph
+     * Usage: WordGraph graph(dictionary);
+     *        WordGraph graph(dictionary, length);
+     * Builds the graph once from every word in the given dictionary, or only from the words of the
+     * given length if one is given
+     * Params: dictionary (Lexicon), length (int, 0 for every length)
+     * ---------------------------------------------------------------------------------------------
+     */
+    WordGraph(const Lexicon &dictionary, int length = 0);
+
+    /*
+     * Method: neighbourCount
+     * Usage: int degree = graph.neighbourCount(id);
+     * Params: id (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the number of one-letter neighbours of the word with the given ID
+     */
+    int neighbourCount(int id) const;
+
+    /*
+     * Method: mapNeighbours
+     * Usage: graph.mapNeighbours(id, fn);
+     * Calls fn(neighbourId) on each one-letter neighbour of the word with the given ID. Neighbours
+     * are visited in the same order as the classic search generates them: by the index of the
+     * changed letter, then from 'a' to 'z'
+     * Params: id (int), fn (function taking an int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: None. Void function
+     */
+    template <typename FunctorType>
+    void mapNeighbours(int id, FunctorType fn) const;
+
+private:
+    void buildAdjacency();
+
+    /* instance variables */
+    std::vector<int> neighbourStart;  // CSR row offsets: neighbours of id are in
+                                      // neighbours[neighbourStart[id] .. neighbourStart[id + 1] - 1]
+    std::vector<int> neighbours;      // CSR column array of neighbour IDs
+};
+
+template <typename FunctorType>
+void WordGraph::mapNeighbours(int id, FunctorType fn) const {
+    int end = neighbourStart[id + 1];
+    for (int i = neighbourStart[id]; i < end; i++) {
+        fn(neighbours[i]);
+    }
+}
+
+#endif // _wordgraph_h
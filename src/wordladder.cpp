@@ -5,35 +5,272 @@
 * code → cade → cate → date → data
 */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "console.h"
+#include "dawglexicon.h"
 #include "lexicon.h"
 #include "filelib.h"
+#include "hashcode.h"
+#include "hashset.h"
 #include "simpio.h"
+#include "strlib.h"
 #include "queue.h"
+#include "priorityqueue.h"
 #include "stack.h"
-#include "set.h"
+#include "componentlabels.h"
+#include "graphfile.h"
+#include "laddertable.h"
+#include "lengthshardedlexicon.h"
+#include "visitedwords.h"
+#include "wildcardindex.h"
+#include "wordgraph.h"
+#include "workstealingpool.h"
 using namespace std;
 
+// How getWordLadder searches for a ladder, set with WORDLADDER_SEARCH
+enum SearchMode {
+    BREADTH_FIRST,  // grow ladders forward from word 1 only
+    BIDIRECTIONAL,  // grow ladders from both ends and join them in the middle
+    A_STAR          // grow the ladders that look closest to word 2 first
+};
+
+// Settings for getWordLadder, read from the environment once in main
+struct SearchOptions {
+    SearchMode mode;
+    bool showCounters;    // display the search counters after each ladder, set with
+                          // WORDLADDER_COUNTERS=on
+    bool showComponents;  // display the component sizes of each word length once its index is
+                          // built, set with WORDLADDER_COMPONENTS=on
+};
+
+// How much work a search did, to compare the search modes
+struct SearchCounters {
+    int expanded;  // words whose neighbours were looked up
+    int queued;    // words added to the queue of words to expand, not counting word 1
+};
+
+// One side of a search: the words it has reached, the word each was reached from, and the words
+// still waiting to be expanded. Entries of previousWords for words not reached in this search are
+// left over from earlier searches and are never read
+struct SearchSide {
+    VisitedWords reached;
+    vector<int> previousWords;
+    Queue<int> queue;
+
+    // Empties the side for a search over word IDs 0 to size - 1. Only the epoch of reached is
+    // bumped; previousWords is grown when needed but never cleared
+    void reset(int size) {
+        reached.reset(size);
+        if ((int) previousWords.size() < size) {
+            previousWords.resize(size);
+        }
+        queue.clear();
+    }
+};
+
+// Scratch space reused from one search to the next instead of being allocated for each search.
+// Searches running at the same time need their own
+struct SearchBuffers {
+    SearchSide fromOne;     // the side growing from word 1, the only side of most searches
+    SearchSide fromTwo;     // the side growing from word 2 in a bidirectional search
+    VisitedWords expanded;  // words an A* search has expanded
+    vector<int> steps;      // steps on the best ladder an A* search knows to each reached word
+};
+
+// Number of batch pairs read before they are answered together when several threads are used
+static const int BATCH_CHUNK_SIZE = 4096;
+
+// A dictionary opened for batch mode, with the neighbour indexes built for it so far
+template <typename NeighbourIndex>
+struct BatchDictionary {
+    unique_ptr<LengthShardedLexicon> lexicon;  // the words of each length are only loaded once a
+                                               // pair of that length is checked
+    vector<unique_ptr<NeighbourIndex>> indexes;  // indexes[L] covers the words of length L, and
+                                                 // is only built once a pair of length L is asked
+    vector<unique_ptr<ComponentLabels>> components;  // components[L] labels indexes[L]
+
+    // The index of a word length holds all its words, so once it is built the shard of that
+    // length is no longer needed to look them up
+    bool contains(const string &word) const {
+        int length = word.length();
+        if (length < (int) indexes.size() && indexes[length]) {
+            return indexes[length]->indexOf(word) != -1;
+        }
+        return lexicon->contains(word);
+    }
+};
+
+// A graph file opened for batch mode. It already holds the neighbours of every word length, so
+// its components are labelled as soon as it is mapped
+struct MappedBatchGraph {
+    MappedWordGraph graph;
+    ComponentLabels components;
+
+    MappedBatchGraph(const string &filename) : graph(filename), components(graph) {}
+};
+
 // Function prototypes
-void getDictionary(Lexicon &dictionary);
+string getDictionary();
+void writeDictionaryGraph(const string &dictionaryFile);
+void writeDictionaryDawg(const string &dictionaryFile);
+void benchmarkDawgChildScans(const string &dawgFile);
+void benchmarkStringHashes(const string &wordFile);
+string getOption(const string &name, const string &defaultValue);
+SearchOptions getSearchOptions();
+int getThreadCount();
+int getShardWordBudget();
+template <typename Dictionary, typename NeighbourIndex>
+void playWordLadders(
+        const Dictionary &dictionary, const NeighbourIndex &index, const SearchOptions &options);
 string getWord(const string &prompt);
 bool emptyWord(string word);
-bool areWordsValid(const Lexicon &dictionary, string wordOne, string wordTwo);
-bool areWordsInDictionary(const Lexicon &dictionary, string wordOne, string wordTwo);
+template <typename Dictionary>
+bool areWordsValid(const Dictionary &dictionary, string wordOne, string wordTwo);
+template <typename Dictionary>
+bool isValidPair(const Dictionary &dictionary, const string &wordOne, const string &wordTwo);
+template <typename Dictionary>
+bool areWordsInDictionary(const Dictionary &dictionary, string wordOne, string wordTwo);
 bool areWordsSameLength(string wordOne, string wordTwo);
 bool areWordsDifferent(string wordOne, string wordTwo);
-void getWordLadder(const Lexicon &dictionary, string wordOne, string wordTwo);
+template <typename NeighbourIndex>
+void playBatchWordLadders(
+        const string &batchFile, const SearchOptions &options, int threadCount, int shardWords);
+template <typename NeighbourIndex>
+void getBatchWordLadders(
+        BatchDictionary<NeighbourIndex> &dictionary,
+        const vector<pair<string, string>> &pairs,
+        const SearchOptions &options,
+        WorkStealingPool &pool,
+        vector<SearchBuffers> &threadBuffers);
+void getBatchWordLadders(
+        MappedBatchGraph &graph,
+        const vector<pair<string, string>> &pairs,
+        const SearchOptions &options,
+        WorkStealingPool &pool,
+        vector<SearchBuffers> &threadBuffers);
+template <typename Dictionary, typename NeighbourIndex>
+void answerBatchPairs(
+        const Dictionary &dictionary,
+        const vector<const NeighbourIndex *> &indexes,
+        const vector<const ComponentLabels *> &components,
+        const vector<pair<string, string>> &pairs,
+        const vector<bool> &valid,
+        const SearchOptions &options,
+        WorkStealingPool &pool,
+        vector<SearchBuffers> &threadBuffers);
+template <typename NeighbourIndex>
+void getWordLadder(
+        const NeighbourIndex &index,
+        const ComponentLabels &components,
+        string wordOne,
+        string wordTwo,
+        const SearchOptions &options,
+        SearchBuffers &buffers);
+template <typename NeighbourIndex>
+void printComponentSizes(
+        const NeighbourIndex &index, const ComponentLabels &components, int length, ostream &out);
+template <typename NeighbourIndex>
+bool searchWordLadder(
+        const NeighbourIndex &index,
+        int idOne,
+        int idTwo,
+        const SearchOptions &options,
+        SearchBuffers &buffers,
+        Stack<int> &ladder,
+        SearchCounters &counters);
+template <typename NeighbourIndex>
+string getLadderText(const NeighbourIndex &index, Stack<int> &ladder);
+template <typename NeighbourIndex>
+bool findWordLadder(
+        const NeighbourIndex &index,
+        int idOne,
+        int idTwo,
+        SearchBuffers &buffers,
+        Stack<int> &ladder,
+        SearchCounters &counters);
+template <typename NeighbourIndex>
 void findPartialWordLadders(
-        const Lexicon &dictionary,
-        Set<string> &usedWords,
-        Queue<Stack<string>> &queue,
-        const Stack<string> &initialLadder);
+        const NeighbourIndex &index, SearchSide &side, int startWord, SearchCounters &counters);
+template <typename NeighbourIndex>
+bool findWordLadderBidirectional(
+        const NeighbourIndex &index,
+        int idOne,
+        int idTwo,
+        SearchBuffers &buffers,
+        Stack<int> &ladder,
+        SearchCounters &counters);
+template <typename NeighbourIndex>
+bool expandFrontier(
+        const NeighbourIndex &index,
+        SearchSide &side,
+        const SearchSide &otherSide,
+        int &meetingWord,
+        int &otherMeetingWord,
+        SearchCounters &counters);
+template <typename NeighbourIndex>
+bool findWordLadderAStar(
+        const NeighbourIndex &index,
+        int idOne,
+        int idTwo,
+        SearchBuffers &buffers,
+        Stack<int> &ladder,
+        SearchCounters &counters);
+int countDifferentLetters(const string &wordOne, const string &wordTwo);
+void pushLadder(const vector<int> &previousWords, int idOne, int idTwo, Stack<int> &ladder);
 
 
 int main() {
-    // Initialising the dictionary as a Lexicon
-    Lexicon dictionary;
+    SearchOptions options = getSearchOptions();
+    bool useWildcardIndex = equalsIgnoreCase(getOption("WORDLADDER_INDEX", "graph"), "wildcard");
+
+    // Write the graph file of a dictionary, for later runs to map instead of building the graph
+    string graphDictionary = getOption("WORDLADDER_WRITE_GRAPH", "");
+    if (graphDictionary != "") {
+        writeDictionaryGraph(graphDictionary);
+        return 0;
+    }
+    // Write a word list as a binary DAWG lexicon, like res/EnglishWords.dat
+    string dawgDictionary = getOption("WORDLADDER_WRITE_DAWG", "");
+    if (dawgDictionary != "") {
+        writeDictionaryDawg(dawgDictionary);
+        return 0;
+    }
+    // Time DAWG lookups with each way of searching a node's children
+    string benchmarkDawg = getOption("WORDLADDER_BENCHMARK_DAWG", "");
+    if (benchmarkDawg != "") {
+        benchmarkDawgChildScans(benchmarkDawg);
+        return 0;
+    }
+    // Time each string hash and count the collisions it makes
+    string benchmarkHash = getOption("WORDLADDER_BENCHMARK_HASH", "");
+    if (benchmarkHash != "") {
+        benchmarkStringHashes(benchmarkHash);
+        return 0;
+    }
+
+    // Answer the pairs in a batch file, or in standard input for -, without any prompts
+    string batchFile = getOption("WORDLADDER_BATCH", "");
+    if (batchFile != "") {
+        if (useWildcardIndex) {
+            playBatchWordLadders<WildcardIndex>(batchFile, options, getThreadCount(),
+                                                getShardWordBudget());
+        } else {
+            playBatchWordLadders<WordGraph>(batchFile, options, getThreadCount(),
+                                            getShardWordBudget());
+        }
+        return 0;
+    }
 
     cout << "Welcome to CS 106B/X Word Ladder!" << endl;
     cout << "Please give me two English words, and I will convert the" << endl;
@@ -42,11 +279,335 @@ int main() {
 
     // Ask for the dictionary file name
 
-    getDictionary(dictionary);
+    string dictionaryFile = getDictionary();
     cout << endl;
 
-    // Repeat the following sequence
+    // A graph file already holds the neighbour graph, and stands in for the dictionary too
+    if (isGraphFile(dictionaryFile)) {
+        MappedWordGraph graph(dictionaryFile);
+        playWordLadders(graph, graph, options);
+    } else {
+        // Initialising the dictionary as a Lexicon
+        Lexicon dictionary(dictionaryFile);
+
+        // Precompute a neighbour index once so each search can walk it by word ID. The full
+        // neighbour graph is the default; the wildcard index is cheaper to build for short-lived
+        // processes
+        if (useWildcardIndex) {
+            WildcardIndex index(dictionary);
+            playWordLadders(dictionary, index, options);
+        } else {
+            WordGraph graph(dictionary);
+            playWordLadders(dictionary, graph, options);
+        }
+    }
+    cout << "Exiting... see you later babes!" << endl;
+    pause(1000);
+    cout << "Have a nice day." << endl;
+    return 0;
+}
+
+/*
+ * Function: getDictionary
+ * Usage: Prompts the user to get the reference dictionary by typing the file name. Reprompts the
+ * user if an invalid name is given. The file is either a word list or a graph file
+ * Params: None
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the dictionary file name (string)
+*/
+
+string getDictionary() {
+    return promptUserForFile("Dictionary file name: ", "Unable to open that file. Try again.");
+}
+
+/*
+ * Function: writeDictionaryGraph
+ * Usage:
+ * Builds the neighbour graph of a dictionary and writes it to a graph file next to the dictionary,
+ * e.g. dictionary.txt to dictionary.graph, which can then be given wherever a dictionary file name
+ * is asked for
+ * Params: dictionaryFile (string)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
 
+void writeDictionaryGraph(const string &dictionaryFile) {
+    if (!isFile(dictionaryFile)) {
+        error("writeDictionaryGraph: Can't open dictionary file " + dictionaryFile);
+    }
+    Lexicon dictionary(dictionaryFile);
+    WordGraph graph(dictionary);
+    string graphFile = getRoot(dictionaryFile) + ".graph";
+    writeGraphFile(graph, graphFile);
+    int neighbourCount = 0;
+    for (int id = 0; id < graph.size(); id++) {
+        neighbourCount += graph.neighbourCount(id);
+    }
+    cout << "Wrote " << graphFile << ": " << graph.size() << " words, " << neighbourCount / 2
+         << " pairs of neighbours" << endl;
+}
+
+/*
+ * Function: writeDictionaryDawg
+ * Usage:
+ * Writes a dictionary to a binary DAWG lexicon file next to it, e.g. dictionary.txt to
+ * dictionary.dat, which is a fraction of the size of the word list and is read as a dictionary
+ * like any other
+ * Params: dictionaryFile (string)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+
+void writeDictionaryDawg(const string &dictionaryFile) {
+    if (!isFile(dictionaryFile)) {
+        error("writeDictionaryDawg: Can't open dictionary file " + dictionaryFile);
+    }
+    DawgLexicon dictionary(dictionaryFile);
+    string dawgFile = getRoot(dictionaryFile) + ".dat";
+    dictionary.writeBinaryFile(dawgFile);
+    cout << "Wrote " << dawgFile << ": " << dictionary.size() << " words" << endl;
+}
+
+/*
+ * Function: benchmarkDawgChildScans
+ * Usage:
+ * Times DawgLexicon lookups with each child scan this machine can run, e.g. on EnglishWords.dat.
+ * Every word is looked up, along with a copy whose last letter is changed so that most lookups
+ * of those miss. Each scan must find the same number of words
+ * Params: dawgFile (string)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+
+void benchmarkDawgChildScans(const string &dawgFile) {
+    if (!isFile(dawgFile)) {
+        error("benchmarkDawgChildScans: Can't open DAWG file " + dawgFile);
+    }
+    DawgLexicon dictionary(dawgFile);
+    vector<string> words;
+    for (const string &word : dictionary) {
+        words.push_back(word);
+        string changed = word;
+        changed.back() = changed.back() == 'z' ? 'a' : changed.back() + 1;
+        words.push_back(changed);
+    }
+
+    const int rounds = 20;
+    const DawgLexicon::ChildScan scans[] = {
+        DawgLexicon::SCALAR_SCAN, DawgLexicon::SSE2_SCAN, DawgLexicon::AVX2_SCAN
+    };
+    const char *scanNames[] = {"scalar", "sse2", "avx2"};
+    cout << dawgFile << ": " << words.size() << " lookups x " << rounds << " rounds" << endl;
+    for (int i = 0; i < 3; i++) {
+        if (!DawgLexicon::isChildScanSupported(scans[i])) {
+            cout << scanNames[i] << ": not supported on this machine" << endl;
+            continue;
+        }
+        dictionary.setChildScan(scans[i]);
+        int found = 0;
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (const string &word : words) {
+                found += dictionary.contains(word);
+            }
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        cout << scanNames[i] << ": " << seconds * 1e9 / ((double) words.size() * rounds)
+             << " ns per lookup, " << found / rounds << " found" << endl;
+    }
+}
+
+/*
+ * Function: benchmarkStringHashes
+ * Usage:
+ * Times each string hash hashCode can use on the words of a word list, e.g. dictionary.txt, and
+ * how long a HashSet takes to fill with them and look each one up. Collisions are counted as words
+ * whose whole hash codes are the same, and as words that land in a bucket already taken in a table
+ * of as many buckets as words, rounded up to a power of 2. Buckets are picked both the way HashMap
+ * picks its home slots, from the top bits of the code times 2^32 divided by the golden ratio, and
+ * from the low bits of the code alone. Both are shown next to the number expected of a perfectly
+ * random hash
+ * Params: wordFile (string)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+
+void benchmarkStringHashes(const string &wordFile) {
+    ifstream input(wordFile.c_str());
+    if (input.fail()) {
+        error("benchmarkStringHashes: Can't open word file " + wordFile);
+    }
+    vector<string> words;
+    string line;
+    while (getline(input, line)) {
+        string word = trim(line);
+        if (word != "") {
+            words.push_back(word);
+        }
+    }
+    int buckets = 2;
+    int bucketBits = 1;
+    while (buckets < (int) words.size()) {
+        buckets *= 2;
+        bucketBits++;
+    }
+    double expected = words.size() - buckets * (1 - pow(1 - 1.0 / buckets, words.size()));
+
+    const int rounds = 50;
+    const StringHash hashes[] = {DJB2_HASH, WORD64_HASH};
+    const char *hashNames[] = {"djb2", "word64"};
+    StringHash defaultHash = getStringHash();
+    cout << wordFile << ": " << words.size() << " words, " << buckets << " buckets, "
+         << (int) round(expected) << " bucket collisions expected" << endl;
+    for (int i = 0; i < 2; i++) {
+        setStringHash(hashes[i]);
+        // hashCode is compiled apart from this file, so the calls can't be optimised away
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (const string &word : words) {
+                hashCode(word);
+            }
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+        vector<int> codes;
+        vector<bool> slotTaken(buckets, false);
+        vector<bool> lowBitsTaken(buckets, false);
+        int slotCollisions = 0;
+        int lowBitsCollisions = 0;
+        for (const string &word : words) {
+            int code = hashCode(word);
+            codes.push_back(code);
+            int slot = ((unsigned) code * 2654435769u) >> (32 - bucketBits);
+            slotCollisions += slotTaken[slot];
+            slotTaken[slot] = true;
+            lowBitsCollisions += lowBitsTaken[code & (buckets - 1)];
+            lowBitsTaken[code & (buckets - 1)] = true;
+        }
+        sort(codes.begin(), codes.end());
+        int distinct = unique(codes.begin(), codes.end()) - codes.begin();
+
+        begin = chrono::steady_clock::now();
+        int found = 0;
+        for (int round = 0; round < rounds; round++) {
+            HashSet<string> set;
+            for (const string &word : words) {
+                set.add(word);
+            }
+            for (const string &word : words) {
+                found += set.contains(word);
+            }
+        }
+        double setSeconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        cout << hashNames[i] << ": " << seconds * 1e9 / ((double) words.size() * rounds)
+             << " ns per hash, " << words.size() - distinct << " codes shared, "
+             << slotCollisions << " bucket collisions by HashMap slot and " << lowBitsCollisions
+             << " by low bits, HashSet "
+             << setSeconds * 1e9 / ((double) words.size() * rounds) << " ns per word added and "
+             << "looked up, " << found / rounds << " found" << endl;
+    }
+    setStringHash(defaultHash);
+}
+
+/*
+ * Function: getOption
+ * Usage:
+ * Reads a setting from the environment, e.g. WORDLADDER_INDEX=wildcard
+ * Params: name (string), defaultValue (string)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the value of the environment variable without surrounding white space, or defaultValue
+ * if it is not set
+*/
+
+string getOption(const string &name, const string &defaultValue) {
+    const char *value = getenv(name.c_str());
+    return value ? trim(value) : defaultValue;
+}
+
+/*
+ * Function: getSearchOptions
+ * Usage:
+ * Reads the search settings from the environment. Searching from both ends or towards word 2
+ * finds ladders of the same length as the plain breadth-first search, but explores far fewer words
+ * Params: None
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the search settings (SearchOptions)
+*/
+
+SearchOptions getSearchOptions() {
+    SearchOptions options = {BREADTH_FIRST, false, false};
+    string search = getOption("WORDLADDER_SEARCH", "bfs");
+    if (equalsIgnoreCase(search, "bidirectional")) {
+        options.mode = BIDIRECTIONAL;
+    } else if (equalsIgnoreCase(search, "astar")) {
+        options.mode = A_STAR;
+    }
+    options.showCounters = equalsIgnoreCase(getOption("WORDLADDER_COUNTERS", "off"), "on");
+    options.showComponents = equalsIgnoreCase(getOption("WORDLADDER_COMPONENTS", "off"), "on");
+    return options;
+}
+
+/*
+ * Function: getThreadCount
+ * Usage:
+ * Reads the number of threads batch mode should use from WORDLADDER_THREADS, which is a number or
+ * auto for one thread per core
+ * Params: None
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the number of threads, at least 1 (int)
+*/
+
+int getThreadCount() {
+    string threads = getOption("WORDLADDER_THREADS", "1");
+    int threadCount = 1;
+    if (equalsIgnoreCase(threads, "auto")) {
+        threadCount = std::thread::hardware_concurrency();
+    } else if (stringIsInteger(threads)) {
+        threadCount = stringToInteger(threads);
+    }
+    return max(threadCount, 1);
+}
+
+/*
+ * Function: getShardWordBudget
+ * Usage:
+ * Reads the most words batch mode should hold in each dictionary's length shards from
+ * WORDLADDER_SHARD_WORDS. Past that, the shards used longest ago are dropped
+ * Params: None
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the number of words, or 0 for no limit (int)
+*/
+
+int getShardWordBudget() {
+    string shardWords = getOption("WORDLADDER_SHARD_WORDS", "0");
+    return stringIsInteger(shardWords) ? max(stringToInteger(shardWords), 0) : 0;
+}
+
+/*
+ * Function: playWordLadders
+ * Usage:
+ * Repeatedly prompts the user for two words and displays the shortest word ladder between them,
+ * until the user enters a blank word
+ * Params: dictionary (Lexicon or MappedWordGraph), index (neighbour index built from the
+ * dictionary), options (SearchOptions)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+
+template <typename Dictionary, typename NeighbourIndex>
+void playWordLadders(
+        const Dictionary &dictionary, const NeighbourIndex &index, const SearchOptions &options) {
+    // Label the components once, so pairs with no ladder between them don't need a search
+    ComponentLabels components(index);
+    if (options.showComponents) {
+        for (int length = 1; index.firstIdOfLength(length) < index.size(); length++) {
+            printComponentSizes(index, components, length, cout);
+        }
+        cout << endl;
+    }
+
+    // Repeat the following sequence, reusing the same scratch space for every search
+    SearchBuffers buffers;
     while (true) {
         // Ask for word 1 and quit the program if it is blank
         string wordOne = getWord("Word 1 (or Enter to quit): ");
@@ -62,30 +623,10 @@ int main() {
         // Perform validation checks on word 1 and word 2 before proceeeding to word ladder stage
         if (areWordsValid(dictionary, wordOne, wordTwo)) {
             //Output shortest word ladder from word 1 to word 2
-            getWordLadder(dictionary, wordOne, wordTwo);
+            getWordLadder(index, components, wordOne, wordTwo, options, buffers);
             cout << endl;
         }
     }
-    cout << "Exiting... see you later babes!" << endl;
-    pause(1000);
-    cout << "Have a nice day." << endl;
-    return 0;
-}
-
-/*
- * Function: getDictionary
- * Usage: Prompts the user to get the reference dictionary by typing the file name. Reprompts the
- * user if an invalid name is given.
- * Params: dictionary (Lexicon)
- * -------------------------------------------------------------------------------------------------
- * Returns: None. Void function
-*/
-
-void getDictionary(Lexicon &dictionary) {
-    string filename = promptUserForFile(
-                "Dictionary file name: ", "Unable to open that file. Try again.");
-
-    dictionary = Lexicon(filename);
 }
 
 
@@ -113,19 +654,37 @@ string getWord(const string &prompt) {
  * a. They are valid words in the dictionary
  * b. The words have the same length
  * c. The words are not the same word
- * Params: dictionary (Lexicon), wordOne (string), wordTwo (string)
+ * Params: dictionary (Lexicon, BatchDictionary or MappedWordGraph), wordOne (string),
+ * wordTwo (string)
  * -----------------------------------------------------------------
  * Returns: true or false
  * NOTE for enhancement: this function would check whether the word is a valid dictionary word here
  * instead and repromt the user to re-enter the word prior to checking other validations
 */
-bool areWordsValid(const Lexicon &dictionary, string wordOne, string wordTwo) {
+template <typename Dictionary>
+bool areWordsValid(const Dictionary &dictionary, string wordOne, string wordTwo) {
     // Check words are valid dictionary words, the same length and different from each other
     return areWordsInDictionary(dictionary, wordOne, wordTwo)
             && areWordsSameLength(wordOne, wordTwo)
             && areWordsDifferent(wordOne, wordTwo);
 }
 
+/*
+ * Function: isValidPair
+ * Usage:
+ * Runs the same checks as areWordsValid without displaying any warnings
+ * Params: dictionary (Lexicon, BatchDictionary or MappedWordGraph), wordOne (string),
+ * wordTwo (string)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: true if areWordsValid would return true
+*/
+
+template <typename Dictionary>
+bool isValidPair(const Dictionary &dictionary, const string &wordOne, const string &wordTwo) {
+    return wordOne.length() == wordTwo.length() && wordOne != wordTwo
+            && dictionary.contains(wordOne) && dictionary.contains(wordTwo);
+}
+
 /*
  * Function: areWordsInDictionary
  * Usage:
@@ -135,7 +694,8 @@ bool areWordsValid(const Lexicon &dictionary, string wordOne, string wordTwo) {
  * Returns: boolean true or false
 */
 
-bool areWordsInDictionary(const Lexicon &dictionary, string wordOne, string wordTwo) {
+template <typename Dictionary>
+bool areWordsInDictionary(const Dictionary &dictionary, string wordOne, string wordTwo) {
     if (!dictionary.contains(wordOne) || !dictionary.contains(wordTwo)) {
         cout << "The two words must be found in the dictionary." << endl;
         return false;
@@ -178,88 +738,724 @@ bool areWordsDifferent(string wordOne, string wordTwo) {
 }
 
 /*
- * Function: getWordLadder
+ * Function: playBatchWordLadders
  * Usage:
- * Find the shortest word ladder from wordOne to wordTwo
- * Params: dictionary (Lexicon), wordOne (string), wordTwo (string)
+ * Answers every pair of words in a batch file without prompting, writing one line per pair: the
+ * shortest ladder from word 2 back to word 1, or the message the prompts would have shown. The
+ * file looks like what a user would type at the prompts: a dictionary file name (names that can't
+ * be opened are skipped), then words one or two per line, then a blank line, after which another
+ * dictionary may follow. The words of each length of a dictionary are only loaded, and their
+ * neighbour index only built, the first time a pair of that length is asked for. A graph file
+ * may be named instead of a dictionary, and is mapped once. With one thread each pair is answered
+ * as soon as it is read; with more, pairs are read in chunks and each chunk is answered in
+ * parallel, still in input order
+ * Params: batchFile (string, - for standard input), options (SearchOptions), threadCount (int),
+ * shardWords (int, the most words each dictionary's length shards may hold, or 0 for no limit)
  * -------------------------------------------------------------------------------------------------
  * Returns: None. Void function
 */
 
-void getWordLadder(const Lexicon &dictionary, string wordOne, string wordTwo) {
-    // Initialise a stack storing word 1 only
-    Stack<string> stack {wordOne};
-    // Initialise a queue of stacks storing the initial stack
-    Queue<Stack<string>> queue {stack};
-    // Initialise a set of words use in any previous ladders so these can be ignored to avoid
-    // reusing words
-    Set<string> usedWords {wordOne};
+template <typename NeighbourIndex>
+void playBatchWordLadders(
+        const string &batchFile, const SearchOptions &options, int threadCount, int shardWords) {
+    ifstream file;
+    if (batchFile != "-") {
+        file.open(batchFile.c_str());
+        if (file.fail()) {
+            error("playBatchWordLadders: Can't open batch file " + batchFile);
+        }
+    }
+    istream &input = batchFile == "-" ? cin : file;
+
+    WorkStealingPool pool(threadCount);
+    vector<SearchBuffers> threadBuffers(pool.size());
+    int chunkSize = pool.size() == 1 ? 1 : BATCH_CHUNK_SIZE;
 
-    // Repeat the following until the queue is empty
-    while (!queue.isEmpty()) {
-        // Stop if word 2 is found
-        if (queue.peek().peek() == wordTwo) {
-            break;
+    map<string, BatchDictionary<NeighbourIndex>> dictionaries;
+    map<string, unique_ptr<MappedBatchGraph>> graphs;
+    // The pairs read so far belong to one of these, or to neither between sections
+    BatchDictionary<NeighbourIndex> *dictionary = nullptr;
+    MappedBatchGraph *graph = nullptr;
+    vector<pair<string, string>> pairs;
+    auto answerPairs = [&]() {
+        if (dictionary != nullptr) {
+            getBatchWordLadders(*dictionary, pairs, options, pool, threadBuffers);
+        } else if (graph != nullptr) {
+            getBatchWordLadders(*graph, pairs, options, pool, threadBuffers);
+        }
+        pairs.clear();
+    };
+    // Word 1 of a pair whose word 2 hasn't been read yet
+    string wordOne;
+    string line;
+    while (getline(input, line)) {
+        line = trim(line);
+        if (line == "") {
+            // A blank line ends the pairs for the current dictionary, like a blank word does
+            answerPairs();
+            dictionary = nullptr;
+            graph = nullptr;
+            wordOne = "";
+        } else if (dictionary == nullptr && graph == nullptr) {
+            if (dictionaries.count(line) == 0 && graphs.count(line) == 0 && !isFile(line)) {
+                cerr << "Unable to open dictionary file " << line << endl;
+                continue;
+            }
+            if (graphs.count(line) != 0 || isGraphFile(line)) {
+                unique_ptr<MappedBatchGraph> &mapped = graphs[line];
+                if (!mapped) {
+                    mapped.reset(new MappedBatchGraph(line));
+                    // Keep the component sizes out of the one-line-per-pair output
+                    const MappedWordGraph &words = mapped->graph;
+                    if (options.showComponents) {
+                        for (int length = 1; words.firstIdOfLength(length) < words.size();
+                             length++) {
+                            printComponentSizes(words, mapped->components, length, cerr);
+                        }
+                    }
+                }
+                graph = mapped.get();
+                continue;
+            }
+            dictionary = &dictionaries[line];
+            if (!dictionary->lexicon) {
+                dictionary->lexicon.reset(new LengthShardedLexicon(line, shardWords));
+            }
+        } else {
+            istringstream words(line);
+            string word;
+            while (words >> word) {
+                if (wordOne == "") {
+                    wordOne = toLowerCase(word);
+                    continue;
+                }
+                pairs.push_back(make_pair(wordOne, toLowerCase(word)));
+                wordOne = "";
+                if ((int) pairs.size() == chunkSize) {
+                    answerPairs();
+                }
+            }
         }
-        // Get the stack containing the first ladder at the front of the queue
-        Stack<string> firstLadder = queue.dequeue();
-        // Find the neighbouring words for the last word on the first Ladder
-        findPartialWordLadders(dictionary, usedWords, queue, firstLadder);
     }
-    // Get the shortest word ladder at the front of the queue
-    if (!queue.isEmpty()) {
-        Stack<string> wordLadderStack = queue.dequeue();
-        // Display the word ladder from word 1 to word 2
-        string wordLadder;
-        for (string word: wordLadderStack) {
-            wordLadder.append(wordLadderStack.pop() + " ");
+    answerPairs();
+}
+
+/*
+ * Function: getBatchWordLadders
+ * Usage:
+ * Writes one line for each pair: the shortest word ladder from word 2 back to word 1, or the
+ * warning for an invalid pair. Indexes for word lengths no earlier pair needed are built first,
+ * one length per task, then the pairs are answered with answerBatchPairs
+ * Params: dictionary (BatchDictionary), pairs (vector of pairs of words), options (SearchOptions),
+ * pool (WorkStealingPool), threadBuffers (vector of SearchBuffers, one per thread of the pool)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+
+template <typename NeighbourIndex>
+void getBatchWordLadders(
+        BatchDictionary<NeighbourIndex> &dictionary,
+        const vector<pair<string, string>> &pairs,
+        const SearchOptions &options,
+        WorkStealingPool &pool,
+        vector<SearchBuffers> &threadBuffers) {
+    // Run the same checks as areWordsValid, but without the warnings, which are written in order
+    // later, and find the word lengths that still need an index. The pairs are checked one word
+    // length at a time, so each length's shard is loaded once even if the shard budget can't hold
+    // every length in the chunk, and kept until its index is built
+    vector<int> byLength(pairs.size());
+    for (int i = 0; i < (int) pairs.size(); i++) {
+        byLength[i] = i;
+    }
+    stable_sort(byLength.begin(), byLength.end(), [&pairs](int a, int b) {
+        return pairs[a].first.length() < pairs[b].first.length();
+    });
+    vector<bool> valid(pairs.size());
+    vector<int> newLengths;
+    vector<shared_ptr<const Lexicon>> shards;  // shards[k] holds the words of length newLengths[k]
+    for (int i : byLength) {
+        valid[i] = isValidPair(dictionary, pairs[i].first, pairs[i].second);
+        int length = pairs[i].first.length();
+        if (valid[i] && (length >= (int) dictionary.indexes.size() || !dictionary.indexes[length])
+                && (newLengths.empty() || newLengths.back() != length)) {
+            newLengths.push_back(length);
+            shards.push_back(dictionary.lexicon->shard(length));
+        }
+    }
+    for (int length : newLengths) {
+        if (length >= (int) dictionary.indexes.size()) {
+            dictionary.indexes.resize(length + 1);
+            dictionary.components.resize(length + 1);
+        }
+    }
+    pool.run(newLengths.size(), [&](int task, int) {
+        int length = newLengths[task];
+        dictionary.indexes[length].reset(new NeighbourIndex(*shards[task], length));
+        dictionary.components[length].reset(new ComponentLabels(*dictionary.indexes[length]));
+    });
+    for (int length : newLengths) {
+        dictionary.lexicon->evict(length);
+    }
+    // Keep the component sizes out of the one-line-per-pair output
+    if (options.showComponents) {
+        for (int length : newLengths) {
+            printComponentSizes(*dictionary.indexes[length], *dictionary.components[length],
+                                length, cerr);
+        }
+    }
+
+    vector<const NeighbourIndex *> indexes(dictionary.indexes.size());
+    vector<const ComponentLabels *> components(dictionary.components.size());
+    for (int length = 0; length < (int) indexes.size(); length++) {
+        indexes[length] = dictionary.indexes[length].get();
+        components[length] = dictionary.components[length].get();
+    }
+    answerBatchPairs(dictionary, indexes, components, pairs, valid, options, pool, threadBuffers);
+}
+
+/*
+ * Function: getBatchWordLadders
+ * Usage:
+ * Writes one line for each pair, as above, searching a mapped graph file, which needs no indexes
+ * built
+ * Params: graph (MappedBatchGraph), pairs (vector of pairs of words), options (SearchOptions),
+ * pool (WorkStealingPool), threadBuffers (vector of SearchBuffers, one per thread of the pool)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+
+void getBatchWordLadders(
+        MappedBatchGraph &graph,
+        const vector<pair<string, string>> &pairs,
+        const SearchOptions &options,
+        WorkStealingPool &pool,
+        vector<SearchBuffers> &threadBuffers) {
+    vector<bool> valid(pairs.size());
+    int maxLength = 0;
+    for (int i = 0; i < (int) pairs.size(); i++) {
+        valid[i] = isValidPair(graph.graph, pairs[i].first, pairs[i].second);
+        if (valid[i]) {
+            maxLength = max(maxLength, (int) pairs[i].first.length());
+        }
+    }
+    // The one graph covers every word length
+    vector<const MappedWordGraph *> indexes(maxLength + 1, &graph.graph);
+    vector<const ComponentLabels *> components(maxLength + 1, &graph.components);
+    answerBatchPairs(graph.graph, indexes, components, pairs, valid, options, pool, threadBuffers);
+}
+
+/*
+ * Function: answerBatchPairs
+ * Usage:
+ * Answers a chunk of batch pairs once their indexes are ready. The searches are spread over the
+ * pool's threads, each search using its thread's buffers. The answers are kept until every search
+ * is done and written in order
+ * Params: dictionary (BatchDictionary or MappedWordGraph), indexes (vector of neighbour
+ * indexes by word length), components (vector of ComponentLabels of the indexes), pairs (vector
+ * of pairs of words), valid (vector of bool, whether each pair passed isValidPair),
+ * options (SearchOptions),
+ * pool (WorkStealingPool), threadBuffers (vector of SearchBuffers, one per thread of the pool)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+
+template <typename Dictionary, typename NeighbourIndex>
+void answerBatchPairs(
+        const Dictionary &dictionary,
+        const vector<const NeighbourIndex *> &indexes,
+        const vector<const ComponentLabels *> &components,
+        const vector<pair<string, string>> &pairs,
+        const vector<bool> &valid,
+        const SearchOptions &options,
+        WorkStealingPool &pool,
+        vector<SearchBuffers> &threadBuffers) {
+    // In breadth-first mode, pairs with the same word 1 are answered together from one
+    // LadderTable, which gives the same ladders as searching for each pair on its own
+    vector<vector<int>> groups;
+    map<string, int> groupOfWord;
+    for (int i = 0; i < (int) pairs.size(); i++) {
+        if (!valid[i]) {
+            continue;
         }
+        if (options.mode == BREADTH_FIRST && groupOfWord.count(pairs[i].first) != 0) {
+            groups[groupOfWord[pairs[i].first]].push_back(i);
+        } else {
+            groupOfWord[pairs[i].first] = groups.size();
+            groups.push_back(vector<int> {i});
+        }
+    }
+
+    vector<string> answers(pairs.size());
+    vector<SearchCounters> counters(pairs.size(), SearchCounters {0, 0});
+    pool.run(groups.size(), [&](int task, int thread) {
+        const vector<int> &group = groups[task];
+        const string &wordOne = pairs[group[0]].first;
+        const NeighbourIndex &index = *indexes[wordOne.length()];
+        const ComponentLabels &labels = *components[wordOne.length()];
+        int idOne = index.indexOf(wordOne);
+        if (group.size() == 1) {
+            const string &wordTwo = pairs[group[0]].second;
+            int idTwo = index.indexOf(wordTwo);
+            Stack<int> wordLadderStack;
+            if (labels.areConnected(idOne, idTwo)
+                    && searchWordLadder(index, idOne, idTwo, options, threadBuffers[thread],
+                                        wordLadderStack, counters[group[0]])) {
+                answers[group[0]] = trim(getLadderText(index, wordLadderStack));
+            } else {
+                answers[group[0]] = "No word ladder found from " + wordTwo + " back to " + wordOne;
+            }
+            return;
+        }
+        LadderTable table(index, idOne);
+        // The whole search is counted against the first pair of the group
+        counters[group[0]].expanded = table.reachableCount();
+        counters[group[0]].queued = table.reachableCount() - 1;
+        for (int i : group) {
+            const string &wordTwo = pairs[i].second;
+            int idTwo = index.indexOf(wordTwo);
+            if (table.isReachable(idTwo)) {
+                Stack<int> wordLadderStack;
+                table.getLadder(idTwo, wordLadderStack);
+                answers[i] = trim(getLadderText(index, wordLadderStack));
+            } else {
+                answers[i] = "No word ladder found from " + wordTwo + " back to " + wordOne;
+            }
+        }
+    });
+
+    for (int i = 0; i < (int) pairs.size(); i++) {
+        if (!valid[i]) {
+            // Invalid pairs get the same one-line warning as at the prompts
+            areWordsValid(dictionary, pairs[i].first, pairs[i].second);
+            continue;
+        }
+        cout << answers[i] << endl;
+        // Keep the counters out of the one-line-per-pair output
+        if (options.showCounters) {
+            cerr << "Expanded " << counters[i].expanded << " words, queued " << counters[i].queued
+                 << " words" << endl;
+        }
+    }
+}
+
+/*
+ * Function: getWordLadder
+ * Usage:
+ * Find the shortest word ladder from wordOne to wordTwo and display it. The search runs over word
+ * IDs in a precomputed neighbour index, and IDs are only turned back into words to display the
+ * ladder
+ * Params: index (WordGraph or WildcardIndex), components (ComponentLabels of the index),
+ * wordOne (string), wordTwo (string), options (SearchOptions), buffers (SearchBuffers)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+
+template <typename NeighbourIndex>
+void getWordLadder(
+        const NeighbourIndex &index,
+        const ComponentLabels &components,
+        string wordOne,
+        string wordTwo,
+        const SearchOptions &options,
+        SearchBuffers &buffers) {
+    int idOne = index.indexOf(wordOne);
+    int idTwo = index.indexOf(wordTwo);
+    // The ladder is built with word 1 at the bottom and word 2 on top
+    Stack<int> wordLadderStack;
+    SearchCounters counters = {0, 0};
+    // Words in different components have no ladder between them, so there is nothing to search
+    if (components.areConnected(idOne, idTwo)
+            && searchWordLadder(index, idOne, idTwo, options, buffers, wordLadderStack, counters)) {
+        // Display the word ladder from word 1 to word 2
         cout << "A ladder from " << wordTwo << " back to " << wordOne << ":" << endl;
-        cout <<  wordLadder << endl;
+        cout << getLadderText(index, wordLadderStack) << endl;
     } else {
         // If no ladder is found, notify the user
         cout << "No word ladder found from " << wordTwo << " back to " << wordOne << endl;
     }
+    if (options.showCounters) {
+        cout << "Expanded " << counters.expanded << " words, queued " << counters.queued
+             << " words" << endl;
+    }
+}
+
+/*
+ * Function: printComponentSizes
+ * Usage:
+ * Display how the words of one length split into components, e.g.
+ * Length 4: 5638 words, 1206 components, largest 4875 words
+ * Params: index (WordGraph, WildcardIndex or MappedWordGraph), components (ComponentLabels of the
+ * index), length (int), out (output stream)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+
+template <typename NeighbourIndex>
+void printComponentSizes(
+        const NeighbourIndex &index, const ComponentLabels &components, int length, ostream &out) {
+    int first = index.firstIdOfLength(length);
+    int count = index.countOfLength(length);
+    if (count == 0) {
+        return;
+    }
+    // The components of one length have consecutive numbers
+    int firstComponent = components.componentOf(first);
+    int lastComponent = firstComponent;
+    for (int id = first; id < first + count; id++) {
+        lastComponent = max(lastComponent, components.componentOf(id));
+    }
+    int largest = 0;
+    for (int component = firstComponent; component <= lastComponent; component++) {
+        largest = max(largest, components.componentSize(component));
+    }
+    out << "Length " << length << ": " << count << " words, "
+        << lastComponent - firstComponent + 1 << " components, largest " << largest << " words"
+        << endl;
+}
+
+/*
+ * Function: searchWordLadder
+ * Usage:
+ * Find the shortest word ladder from word 1 to word 2 with the search mode in the options
+ * Params: index (WordGraph or WildcardIndex), idOne (int), idTwo (int), options (SearchOptions),
+ * buffers (SearchBuffers), ladder (Stack of word IDs, filled with the ladder from word 1 at the
+ * bottom to word 2 on top), counters (SearchCounters)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: true if a ladder was found
+*/
+
+template <typename NeighbourIndex>
+bool searchWordLadder(
+        const NeighbourIndex &index,
+        int idOne,
+        int idTwo,
+        const SearchOptions &options,
+        SearchBuffers &buffers,
+        Stack<int> &ladder,
+        SearchCounters &counters) {
+    if (options.mode == BIDIRECTIONAL) {
+        return findWordLadderBidirectional(index, idOne, idTwo, buffers, ladder, counters);
+    } else if (options.mode == A_STAR) {
+        return findWordLadderAStar(index, idOne, idTwo, buffers, ladder, counters);
+    }
+    return findWordLadder(index, idOne, idTwo, buffers, ladder, counters);
+}
+
+/*
+ * Function: getLadderText
+ * Usage:
+ * Spell out a word ladder from word 2 back to word 1, emptying the stack
+ * Params: index (WordGraph or WildcardIndex), ladder (Stack of word IDs with word 2 on top)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the words of the ladder, each followed by a space (string)
+*/
+
+template <typename NeighbourIndex>
+string getLadderText(const NeighbourIndex &index, Stack<int> &ladder) {
+    string wordLadder;
+    while (!ladder.isEmpty()) {
+        wordLadder.append(index.wordAt(ladder.pop()) + " ");
+    }
+    return wordLadder;
+}
+
+/*
+ * Function: findWordLadder
+ * Usage:
+ * Breadth-first search for the shortest word ladder from word 1 to word 2, growing partial ladders
+ * forward from word 1 until one reaches word 2. Each partial ladder is stored as just its last
+ * word and the word before it, and the whole ladder is only built once word 2 has been reached
+ * Params: index (WordGraph or WildcardIndex), idOne (int), idTwo (int), buffers (SearchBuffers),
+ * ladder (Stack of word IDs, filled with the ladder from word 1 at the bottom to word 2 on top),
+ * counters (SearchCounters)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: true if a ladder was found
+*/
+
+template <typename NeighbourIndex>
+bool findWordLadder(
+        const NeighbourIndex &index,
+        int idOne,
+        int idTwo,
+        SearchBuffers &buffers,
+        Stack<int> &ladder,
+        SearchCounters &counters) {
+    // Initialise a queue of the words whose neighbours are still to be explored, storing word 1,
+    // and mark word 1 as reached. Words reached are never reached again, so no word is reused.
+    // Resetting the side only bumps an epoch, so nothing is cleared word by word
+    SearchSide &side = buffers.fromOne;
+    side.reset(index.size());
+    side.queue.enqueue(idOne);
+    side.reached.add(idOne);
+    side.previousWords[idOne] = idOne;
+
+    // Repeat the following until the queue is empty or word 2 has been reached
+    while (!side.queue.isEmpty() && !side.reached.contains(idTwo)) {
+        // Find the neighbouring words for the word at the front of the queue
+        findPartialWordLadders(index, side, side.queue.dequeue(), counters);
+    }
+    if (!side.reached.contains(idTwo)) {
+        return false;
+    }
+    pushLadder(side.previousWords, idOne, idTwo, ladder);
+    return true;
 }
 
 /*
  * Function: findPartialWordLadders
  * Usage:
  * Find all the neighbour words from a given start word, which is a word of the same length but
- * differs from the start word by exactly 1 letter e.g. date and data, and create partial word
- * ladders using this information in order to find final word ladder
- * Params: dictionary (Lexicon), usedWords (Set), queue (Queue of Stacks of strings),
- * firstLadder (Stack of strings)
+ * differs from the start word by exactly 1 letter e.g. date and data, and extend the partial word
+ * ladder ending at the start word to each of them. The neighbours come straight from the
+ * precomputed index instead of trying every letter at every position
+ * Params: index (WordGraph or WildcardIndex), side (SearchSide), startWord (int), counters
+ * (SearchCounters)
  * -------------------------------------------------------------------------------------------------
  * Returns: None. Void function
 */
+template <typename NeighbourIndex>
 void findPartialWordLadders(
-        const Lexicon &dictionary,
-        Set<string> &usedWords,
-        Queue<Stack<string>> &queue,
-        const Stack<string> &firstLadder) {
-
-    // Get the start word at the top of the initial word ladder
-    string startWord = firstLadder.peek();
-    // The algorith uses 2 nested loops for efficiency: 1st loop for index of the start word,
-    // 2nd loop to loop through a-z of the alphabet
-    for (int i = 0; i < startWord.length(); i++) {
-        for (char letter = 'a'; letter <='z'; letter++) {
-            // Copy the start word to create the neighbour word
-            string neighbourWord = startWord;
-            // Replace each letter in the neighbour word with another letter from a to z in turn to
-            // find all valid word combinations
-            neighbourWord[i] = letter;
-            // Check word combination is a valid dictionary word and it hasn't been used already
-            if (dictionary.contains(neighbourWord) && !usedWords.contains(neighbourWord)) {
-                // Add the neighbour word to the set of used words
-                usedWords.add(neighbourWord);
-                // Create a copy of the initial ladder and add the neighbour word on top
-                Stack<string> newLadder = firstLadder;
-                newLadder.push(neighbourWord);
-                // Add the new ladder into the queue
-                queue.enqueue(newLadder);
+        const NeighbourIndex &index, SearchSide &side, int startWord, SearchCounters &counters) {
+
+    counters.expanded++;
+    // The index lists the neighbours in the order the letter-by-letter search used to find them:
+    // by index of the changed letter, then from a to z
+    index.mapNeighbours(startWord, [&](int neighbourWord) {
+        // Check the neighbour word hasn't been used already
+        if (!side.reached.contains(neighbourWord)) {
+            // Extend the ladder ending at the start word to the neighbour word
+            side.reached.add(neighbourWord);
+            side.previousWords[neighbourWord] = startWord;
+            // Add the neighbour word into the queue
+            side.queue.enqueue(neighbourWord);
+            counters.queued++;
+        }
+    });
+}
+
+/*
+ * Function: findWordLadderBidirectional
+ * Usage:
+ * Search for the shortest word ladder from both ends at once. Each side records the word it
+ * reached every word from, and each round expands one whole level of whichever frontier is
+ * smaller. The search stops as soon as one side reaches a word the other side has seen, and the
+ * two half-ladders are joined there. Because whole levels are expanded and the sides never overlap
+ * before that, the first meeting already gives a shortest ladder
+ * Params: index (WordGraph or WildcardIndex), idOne (int), idTwo (int), buffers (SearchBuffers),
+ * ladder (Stack of word IDs, filled with the ladder from word 1 at the bottom to word 2 on top),
+ * counters (SearchCounters)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: true if a ladder was found
+*/
+
+template <typename NeighbourIndex>
+bool findWordLadderBidirectional(
+        const NeighbourIndex &index,
+        int idOne,
+        int idTwo,
+        SearchBuffers &buffers,
+        Stack<int> &ladder,
+        SearchCounters &counters) {
+    // Each side records the word before each word it has reached; -1 marks the end word. A side's
+    // queue is its frontier
+    SearchSide &forward = buffers.fromOne;
+    SearchSide &backward = buffers.fromTwo;
+    forward.reset(index.size());
+    backward.reset(index.size());
+    forward.reached.add(idOne);
+    forward.previousWords[idOne] = -1;
+    forward.queue.enqueue(idOne);
+    backward.reached.add(idTwo);
+    backward.previousWords[idTwo] = -1;
+    backward.queue.enqueue(idTwo);
+    // The meeting is an edge from a word reached from word 1 to a word reached from word 2
+    int forwardEnd = -1;
+    int backwardEnd = -1;
+    bool found = false;
+
+    // Stop when either side runs out of words: then the two words are not connected
+    while (!found && !forward.queue.isEmpty() && !backward.queue.isEmpty()) {
+        if (forward.queue.size() <= backward.queue.size()) {
+            found = expandFrontier(index, forward, backward, forwardEnd, backwardEnd, counters);
+        } else {
+            found = expandFrontier(index, backward, forward, backwardEnd, forwardEnd, counters);
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    // Walk back from the meeting to word 1, then push that half in ladder order
+    Stack<int> firstHalf;
+    for (int word = forwardEnd; word != -1; word = forward.previousWords[word]) {
+        firstHalf.push(word);
+    }
+    while (!firstHalf.isEmpty()) {
+        ladder.push(firstHalf.pop());
+    }
+    // The second half is already in ladder order when walked back to word 2
+    for (int word = backwardEnd; word != -1; word = backward.previousWords[word]) {
+        ladder.push(word);
+    }
+    return true;
+}
+
+/*
+ * Function: expandFrontier
+ * Usage:
+ * Replace every word of one side's frontier with its unseen neighbours, stopping early if a
+ * neighbour has already been reached by the other side
+ * Params: index (WordGraph or WildcardIndex), side (SearchSide, whose queue is the frontier),
+ * otherSide (SearchSide), meetingWord (int, set to the word on this side of the meeting),
+ * otherMeetingWord (int, set to the word on the other side), counters (SearchCounters)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: true if the two sides met
+*/
+
+template <typename NeighbourIndex>
+bool expandFrontier(
+        const NeighbourIndex &index,
+        SearchSide &side,
+        const SearchSide &otherSide,
+        int &meetingWord,
+        int &otherMeetingWord,
+        SearchCounters &counters) {
+    // Only expand the words already in the frontier, so that one whole level is done at a time
+    for (int remaining = side.queue.size(); remaining > 0; remaining--) {
+        int word = side.queue.dequeue();
+        counters.expanded++;
+        bool met = false;
+        index.mapNeighbours(word, [&](int neighbourWord) {
+            if (met || side.reached.contains(neighbourWord)) {
+                return;
+            }
+            if (otherSide.reached.contains(neighbourWord)) {
+                meetingWord = word;
+                otherMeetingWord = neighbourWord;
+                met = true;
+                return;
+            }
+            side.reached.add(neighbourWord);
+            side.previousWords[neighbourWord] = word;
+            side.queue.enqueue(neighbourWord);
+            counters.queued++;
+        });
+        if (met) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Function: findWordLadderAStar
+ * Usage:
+ * A* search for the shortest word ladder from word 1 to word 2. Words are expanded in order of
+ * the length of the ladder to them plus the number of letters still different from word 2. A
+ * ladder can't change more than one letter a step, so that sum never overestimates the length of
+ * a whole ladder through the word, and the first time word 2 is expanded its ladder is a shortest
+ * one. Among words with the same sum, the ones furthest along are expanded first
+ * Params: index (WordGraph or WildcardIndex), idOne (int), idTwo (int), buffers (SearchBuffers),
+ * ladder (Stack of word IDs, filled with the ladder from word 1 at the bottom to word 2 on top),
+ * counters (SearchCounters)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: true if a ladder was found
+*/
+
+template <typename NeighbourIndex>
+bool findWordLadderAStar(
+        const NeighbourIndex &index,
+        int idOne,
+        int idTwo,
+        SearchBuffers &buffers,
+        Stack<int> &ladder,
+        SearchCounters &counters) {
+    const string &target = index.wordAt(idTwo);
+    // A ladder is never longer than the number of words, so subtracting steps / tieBreak from a
+    // priority only orders words that would otherwise tie
+    double tieBreak = index.size() + 1.0;
+    // The best known number of steps to each reached word, and the word before it on that ladder
+    SearchSide &side = buffers.fromOne;
+    side.reset(index.size());
+    vector<int> &steps = buffers.steps;
+    if ((int) steps.size() < index.size()) {
+        steps.resize(index.size());
+    }
+    vector<int> &previousWords = side.previousWords;
+    // A word can be queued again when a shorter ladder to it is found, so expanded words are
+    // marked to skip their stale entries
+    VisitedWords &expanded = buffers.expanded;
+    expanded.reset(index.size());
+    PriorityQueue<int> queue;
+
+    side.reached.add(idOne);
+    steps[idOne] = 0;
+    previousWords[idOne] = idOne;
+    queue.enqueue(idOne, countDifferentLetters(index.wordAt(idOne), target));
+    while (!queue.isEmpty()) {
+        int word = queue.dequeue();
+        if (expanded.contains(word)) {
+            continue;
+        }
+        if (word == idTwo) {
+            pushLadder(previousWords, idOne, idTwo, ladder);
+            return true;
+        }
+        expanded.add(word);
+        counters.expanded++;
+        int nextSteps = steps[word] + 1;
+        index.mapNeighbours(word, [&](int neighbourWord) {
+            if (!expanded.contains(neighbourWord) && (!side.reached.contains(neighbourWord)
+                                                      || nextSteps < steps[neighbourWord])) {
+                side.reached.add(neighbourWord);
+                steps[neighbourWord] = nextSteps;
+                previousWords[neighbourWord] = word;
+                int lettersLeft = countDifferentLetters(index.wordAt(neighbourWord), target);
+                queue.enqueue(neighbourWord, nextSteps + lettersLeft - nextSteps / tieBreak);
+                counters.queued++;
             }
+        });
+    }
+    return false;
+}
+
+/*
+ * Function: countDifferentLetters
+ * Usage:
+ * Count the positions at which two words of the same length have different letters
+ * Params: wordOne (string), wordTwo (string)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: the number of different letters (int)
+*/
+
+int countDifferentLetters(const string &wordOne, const string &wordTwo) {
+    int count = 0;
+    for (int i = 0; i < (int) wordOne.length(); i++) {
+        if (wordOne[i] != wordTwo[i]) {
+            count++;
         }
     }
+    return count;
+}
+
+/*
+ * Function: pushLadder
+ * Usage:
+ * Build the ladder to word 2 from the word each word was reached from, by walking back from word 2
+ * to word 1 and then pushing the words in ladder order
+ * Params: previousWords (vector of word IDs), idOne (int), idTwo (int), ladder (Stack of word IDs,
+ * filled with word 1 at the bottom and word 2 on top)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+
+void pushLadder(const vector<int> &previousWords, int idOne, int idTwo, Stack<int> &ladder) {
+    Stack<int> reversedLadder;
+    for (int word = idTwo; word != idOne; word = previousWords[word]) {
+        reversedLadder.push(word);
+    }
+    ladder.push(idOne);
+    while (!reversedLadder.isEmpty()) {
+        ladder.push(reversedLadder.pop());
+    }
 }
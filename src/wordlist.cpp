@@ -0,0 +1,89 @@
+/*
+* This is the implementation of the WordList class. The dictionary is read in alphabetical order
+* and a counting sort on word length lays the words out by length without disturbing that order.
+*/
+
+#include <algorithm>
+#include "wordlist.h"
+using namespace std;
+
+WordList::WordList(const Lexicon &dictionary, int length) {
+    auto isListed = [length](const string &word) {
+        return length == 0 || (int) word.length() == length;
+    };
+    int maxLength = 0;
+    for (const string &word : dictionary) {
+        if (isListed(word)) {
+            maxLength = max(maxLength, (int) word.length());
+        }
+    }
+    // Count the words of each length, then turn the counts into the first ID of each length
+    lengthStart = vector<int>(maxLength + 2, 0);
+    for (const string &word : dictionary) {
+        if (isListed(word)) {
+            lengthStart[word.length() + 1]++;
+        }
+    }
+    for (int i = 1; i < (int) lengthStart.size(); i++) {
+        lengthStart[i] += lengthStart[i - 1];
+    }
+    vector<int> nextId = lengthStart;
+    words = vector<string>(lengthStart[maxLength + 1]);
+    for (const string &word : dictionary) {
+        if (isListed(word)) {
+            words[nextId[word.length()]++] = word;
+        }
+    }
+}
+
+int WordList::indexOf(const string &word) const {
+    int length = word.length();
+    if (length <= 0 || length + 1 >= (int) lengthStart.size()) {
+        return -1;
+    }
+    // Words of the same length are stored alphabetically, so binary search their ID range
+    int low = lengthStart[length];
+    int high = lengthStart[length + 1] - 1;
+    while (low <= high) {
+        int middle = low + (high - low) / 2;
+        int comparison = words[middle].compare(word);
+        if (comparison == 0) {
+            return middle;
+        } else if (comparison < 0) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return -1;
+}
+
+const string &WordList::wordAt(int id) const {
+    return words[id];
+}
+
+int WordList::size() const {
+    return words.size();
+}
+
+int WordList::firstIdOfLength(int length) const {
+    if (length <= 0 || length + 1 >= (int) lengthStart.size()) {
+        return size();
+    }
+    return lengthStart[length];
+}
+
+int WordList::countOfLength(int length) const {
+    if (length <= 0 || length + 1 >= (int) lengthStart.size()) {
+        return 0;
+    }
+    return lengthStart[length + 1] - lengthStart[length];
+}
+
+int compareExceptAt(const string &wordOne, const string &wordTwo, int position) {
+    int comparison = wordOne.compare(0, position, wordTwo, 0, position);
+    if (comparison != 0) {
+        return comparison;
+    }
+    return wordOne.compare(position + 1, string::npos, wordTwo, position + 1, string::npos);
+}
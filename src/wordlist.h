@@ -0,0 +1,93 @@
+/*
+* This file declares the WordList class, which gives every word of a dictionary an integer ID.
+* IDs are grouped by word length and are in alphabetical order within each length, so the words
+* of one length always occupy one contiguous range of IDs. The neighbour indexes used by the word
+* ladder search are built on top of a WordList and search by ID.
+*/
+
+#ifndef _wordlist_h
+#define _wordlist_h
+
+#include <string>
+#include <vector>
+#include "lexicon.h"
+
+class WordList {
+public:
+    /*
+     * Constructor: WordList
+     * Usage: WordList words(dictionary);
+     *        WordList words(dictionary, length);
+     * Gives an ID to every word in the given dictionary, or only to the words of the given length
+     * if one is given
+     * Params: dictionary (Lexicon), length (int, 0 for every length)
+     * ---------------------------------------------------------------------------------------------
+     */
+    WordList(const Lexicon &dictionary, int length = 0);
+
+    /*
+     * Method: indexOf
+     * Usage: int id = words.indexOf(word);
+     * Looks up the ID of a word. The word must already be in lowercase
+     * Params: word (string)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the word's ID, or -1 if the word is not in the list
+     */
+    int indexOf(const std::string &word) const;
+
+    /*
+     * Method: wordAt
+     * Usage: string word = words.wordAt(id);
+     * Params: id (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the word with the given ID
+     */
+    const std::string &wordAt(int id) const;
+
+    /*
+     * Method: size
+     * Usage: int n = words.size();
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the number of words in the list
+     */
+    int size() const;
+
+    /*
+     * Method: firstIdOfLength
+     * Usage: int first = words.firstIdOfLength(length);
+     * The words of one length have consecutive IDs, from firstIdOfLength(length) to
+     * firstIdOfLength(length) + countOfLength(length) - 1
+     * Params: length (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the ID of the first word of the given length
+     */
+    int firstIdOfLength(int length) const;
+
+    /*
+     * Method: countOfLength
+     * Usage: int n = words.countOfLength(length);
+     * Params: length (int)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the number of words of the given length
+     */
+    int countOfLength(int length) const;
+
+protected:
+    /* instance variables */
+    std::vector<std::string> words;  // all words, ordered by length then alphabetically
+    std::vector<int> lengthStart;    // lengthStart[L] is the first ID of a word of length L
+};
+
+/*
+ * Function: compareExceptAt
+ * Usage: if (compareExceptAt(wordOne, wordTwo, i) == 0) ...
+ * Compares two words of the same length alphabetically as if the letter at the given position
+ * were removed from both. Two different words compare equal exactly when they are neighbours
+ * that differ at that position
+ * Params: wordOne (string), wordTwo (string), position (int)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: a negative number, zero or a positive number, like string::compare
+*/
+int compareExceptAt(const std::string &wordOne, const std::string &wordTwo, int position);
+
+#endif // _wordlist_h
@@ -0,0 +1,140 @@
+/*
+* This is the implementation of the WorkStealingPool class. The worker threads sleep on a
+* condition variable between runs. A run deals out the tasks, bumps the generation number to wake
+* the workers, then works alongside them as thread 0 until no thread has a task left to take.
+*/
+
+#include <cstdint>
+#include "workstealingpool.h"
+using namespace std;
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+        : job(nullptr), generation(0), busyWorkers(0), stopping(false) {
+    if (threadCount < 1) {
+        threadCount = 1;
+    }
+    for (int thread = 0; thread < threadCount; thread++) {
+        deques.push_back(unique_ptr<TaskDeque>(new TaskDeque()));
+    }
+    for (int thread = 1; thread < threadCount; thread++) {
+        workers.push_back(std::thread(&WorkStealingPool::workerLoop, this, thread));
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+int WorkStealingPool::size() const {
+    return deques.size();
+}
+
+void WorkStealingPool::run(int taskCount, const function<void(int, int)> &fn) {
+    if (taskCount <= 0) {
+        return;
+    }
+    // Neighbouring tasks often need the same data, so each thread starts on a contiguous block
+    int threadCount = size();
+    for (int thread = 0; thread < threadCount; thread++) {
+        deque<int> &tasks = deques[thread]->tasks;
+        for (int task = (int64_t) taskCount * thread / threadCount;
+                task < (int64_t) taskCount * (thread + 1) / threadCount; task++) {
+            tasks.push_back(task);
+        }
+    }
+    {
+        lock_guard<mutex> guard(lock);
+        job = &fn;
+        busyWorkers = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+    runTasks(0);
+    unique_lock<mutex> guard(lock);
+    finished.wait(guard, [this] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+/*
+ * Function: workerLoop
+ * Usage:
+ * The body of each worker thread: waits for a run to start, takes part in it, and repeats until
+ * the pool is stopped
+ * Params: thread (int, the worker's thread number)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+void WorkStealingPool::workerLoop(int thread) {
+    int runsSeen = 0;
+    while (true) {
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [this, runsSeen] { return stopping || generation != runsSeen; });
+            if (stopping) {
+                return;
+            }
+            runsSeen = generation;
+        }
+        runTasks(thread);
+        {
+            lock_guard<mutex> guard(lock);
+            busyWorkers--;
+        }
+        finished.notify_one();
+    }
+}
+
+/*
+ * Function: runTasks
+ * Usage:
+ * Runs tasks on the given thread until there are none left to take
+ * Params: thread (int)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: None. Void function
+*/
+void WorkStealingPool::runTasks(int thread) {
+    int task;
+    while (takeTask(thread, task)) {
+        (*job)(task, thread);
+    }
+}
+
+/*
+ * Function: takeTask
+ * Usage:
+ * Takes the next task from the front of the thread's own deque, or failing that steals one from
+ * the back of another thread's deque. No tasks are added during a run, so once every deque is
+ * empty the thread is done
+ * Params: thread (int), task (int, set to the task taken)
+ * -------------------------------------------------------------------------------------------------
+ * Returns: true if a task was taken
+*/
+bool WorkStealingPool::takeTask(int thread, int &task) {
+    {
+        TaskDeque &own = *deques[thread];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    int threadCount = size();
+    for (int i = 1; i < threadCount; i++) {
+        TaskDeque &victim = *deques[(thread + i) % threadCount];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,89 @@
+/*
+* This file declares the WorkStealingPool class, a fixed set of threads for running many small
+* independent tasks, such as the word ladder queries of a batch. Each run deals the tasks out to
+* the threads in contiguous blocks, and a thread that finishes its own block steals tasks from the
+* back of another thread's block, so slow tasks don't leave the other threads idle. Every task is
+* told which thread runs it, so it can use scratch space that belongs to that thread alone.
+*/
+
+#ifndef _workstealingpool_h
+#define _workstealingpool_h
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    /*
+     * Constructor: WorkStealingPool
+     * Usage: WorkStealingPool pool(threadCount);
+     * Starts the pool. The thread that calls run counts as one of the threads, so
+     * threadCount - 1 new threads are started
+     * Params: threadCount (int, at least 1)
+     * ---------------------------------------------------------------------------------------------
+     */
+    WorkStealingPool(int threadCount);
+
+    /*
+     * Destructor: ~WorkStealingPool
+     * Stops and joins the pool's threads
+     * ---------------------------------------------------------------------------------------------
+     */
+    ~WorkStealingPool();
+
+    /*
+     * Method: size
+     * Usage: int threads = pool.size();
+     * ---------------------------------------------------------------------------------------------
+     * Returns: the number of threads that run tasks, including the calling thread
+     */
+    int size() const;
+
+    /*
+     * Method: run
+     * Usage: pool.run(taskCount, fn);
+     * Calls fn(task, thread) once for every task from 0 to taskCount - 1, spread over the pool's
+     * threads, and returns when they have all finished. thread is from 0 to size() - 1, and no two
+     * tasks with the same thread run at the same time
+     * Params: taskCount (int), fn (function taking a task number and a thread number)
+     * ---------------------------------------------------------------------------------------------
+     * Returns: None. Void function
+     */
+    void run(int taskCount, const std::function<void(int, int)> &fn);
+
+private:
+    /*
+     * The tasks dealt to one thread. The owner takes tasks from the front and thieves take them
+     * from the back, so they only contend for the last few tasks
+     */
+    struct TaskDeque {
+        std::mutex lock;
+        std::deque<int> tasks;
+    };
+
+    void workerLoop(int thread);
+    void runTasks(int thread);
+    bool takeTask(int thread, int &task);
+
+    /* instance variables */
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<TaskDeque>> deques;  // one per thread, by thread number
+    const std::function<void(int, int)> *job;        // the function of the current run
+    std::mutex lock;                                 // guards the variables below
+    std::condition_variable wake;                    // signalled to start a run or to stop
+    std::condition_variable finished;                // signalled when a worker ends a run
+    int generation;                                  // number of runs started so far
+    int busyWorkers;                                 // workers still in the current run
+    bool stopping;
+
+    // Copying a pool would mean copying its threads
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator =(const WorkStealingPool &) = delete;
+};
+
+#endif // _workstealingpool_h